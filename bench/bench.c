@@ -0,0 +1,647 @@
+/**
+ * @file bench.c
+ * @author Daniel Chung
+ * @brief Microbenchmarks for the containers and the headless game tick
+ * @version 0.1
+ * @date 2024-04-04
+ *
+ * Built and run by `make bench`. Each case prints one CSV row of
+ * bench,param,ops,ns_per_op,ops_per_sec,allocs_per_op to stdout.
+ *
+ * The binary is linked with --wrap for malloc, calloc and realloc, so every
+ * allocation made by the repo's own code goes through a counter here.
+ *
+ * Before timing anything it checks the paths that are fast because they
+ * skip work, the vecenv_t kernels against game_t and the incremental hash
+ * against a full recompute, and exits non-zero if either drifts.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include "dyn_arr.h"
+#include "sll.h"
+#include "game.h"
+#include "vecenv.h"
+#include "batch.h"
+
+#define BENCH_NSEC_PER_SEC 1000000000LL
+#define BENCH_TICKS        100000
+// a fixed seed so every run spawns the same food
+#define BENCH_SEED         1
+#define BENCH_STEPS        1000
+#define BENCH_SNAPSHOTS    10000
+// a multiple of 4, see bench_cycle_dir
+#define BENCH_VEC_SIZE     16
+// not a multiple of 8, so the AVX2 kernel leaves some games to the scalar one
+#define BENCH_CHECK_GAMES  37
+#define BENCH_CHECK_TICKS  3000
+
+void * __real_malloc (size_t size);
+void * __real_calloc (size_t count, size_t size);
+void * __real_realloc (void * p_ptr, size_t size);
+
+static size_t g_allocs = 0;
+
+void * __wrap_malloc (size_t size)
+{
+    g_allocs++;
+    return __real_malloc(size);
+}
+
+void * __wrap_calloc (size_t count, size_t size)
+{
+    g_allocs++;
+    return __real_calloc(count, size);
+}
+
+void * __wrap_realloc (void * p_ptr, size_t size)
+{
+    g_allocs++;
+    return __real_realloc(p_ptr, size);
+}
+
+/**
+ * @brief Running measurement for one benchmark case
+ *
+ * @param bench_t::start Time the case started
+ * @param bench_t::allocs Allocation count when the case started
+ */
+typedef struct bench_t
+{
+    struct timespec start;
+    size_t          allocs;
+} bench_t;
+
+// keeps results live so the compiler cannot drop the measured calls
+static volatile uintptr_t g_sink = 0;
+
+static void bench_start (bench_t * p_bench)
+{
+    p_bench->allocs = g_allocs;
+    clock_gettime(CLOCK_MONOTONIC, &p_bench->start);
+}
+
+static void bench_stop (bench_t *    p_bench,
+                        const char * p_name,
+                        size_t       param,
+                        size_t       ops)
+{
+    struct timespec end = { 0 };
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    int64_t elapsed
+        = ((int64_t)(end.tv_sec - p_bench->start.tv_sec) * BENCH_NSEC_PER_SEC)
+          + (end.tv_nsec - p_bench->start.tv_nsec);
+    double ns_per_op = (double)elapsed / (double)ops;
+
+    printf("%s,%zu,%zu,%.2f,%.0f,%.4f\n",
+           p_name,
+           param,
+           ops,
+           ns_per_op,
+           (0 < ns_per_op) ? (BENCH_NSEC_PER_SEC / ns_per_op) : 0.0,
+           (double)(g_allocs - p_bench->allocs) / (double)ops);
+}
+
+static int bench_cmp (void * p_lhs, void * p_rhs)
+{
+    return (*(void **)p_lhs == *(void **)p_rhs) ? 0 : 1;
+}
+
+static void bench_dyn_arr (size_t count)
+{
+    bench_t     bench     = { 0 };
+    dyn_arr_t * p_dyn_arr = dyn_arr_create_unsync(DEFAULT_ARR_CAP);
+
+    bench_start(&bench);
+
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        dyn_arr_append(p_dyn_arr, (void *)(idx + 1));
+    }
+
+    bench_stop(&bench, "dyn_arr_append", count, count);
+    bench_start(&bench);
+
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        g_sink += (uintptr_t)dyn_arr_get(p_dyn_arr, (idx * 7919) % count);
+    }
+
+    bench_stop(&bench, "dyn_arr_get", count, count);
+    bench_start(&bench);
+
+    // front removal is the worst case for the shifting remove
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        dyn_arr_remove(p_dyn_arr, 0);
+    }
+
+    bench_stop(&bench, "dyn_arr_remove", count, count);
+
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        dyn_arr_append(p_dyn_arr, (void *)(idx + 1));
+    }
+
+    bench_start(&bench);
+
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        dyn_arr_swap_remove(p_dyn_arr, 0);
+    }
+
+    bench_stop(&bench, "dyn_arr_swap_remove", count, count);
+    dyn_arr_destroy(&p_dyn_arr);
+}
+
+static void bench_sll (size_t count)
+{
+    bench_t bench   = { 0 };
+    sll_t * p_sll   = sll_create_unsync(bench_cmp);
+    size_t  lookups = (count < 1000) ? count : 1000;
+
+    bench_start(&bench);
+
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        sll_prepend(p_sll, (void *)(idx + 1), false);
+    }
+
+    bench_stop(&bench, "sll_prepend", count, count);
+    bench_start(&bench);
+
+    // the first value prepended is the last node, the worst case for a scan
+    for (size_t idx = 0; idx < lookups; idx++)
+    {
+        g_sink += sll_is_in(p_sll, (void *)1);
+    }
+
+    bench_stop(&bench, "sll_is_in", count, lookups);
+    bench_start(&bench);
+
+    for (size_t idx = 0; idx < lookups; idx++)
+    {
+        g_sink += (uintptr_t)sll_get(p_sll, (idx * 7919) % count);
+    }
+
+    bench_stop(&bench, "sll_get", count, lookups);
+    sll_destroy(&p_sll);
+}
+
+/**
+ * @brief Gets the direction of a Hamiltonian cycle at a cell
+ *
+ * @note Column 0 runs up, the other columns are covered by rows snaking down.
+ * The cycle passes through the starting snake heading right, so a game
+ * following it never dies until the board is full. game_size must be a
+ * multiple of 4 so the snake starts on a row that runs right.
+ */
+static point_t bench_cycle_dir (point_t pos, size_t game_size)
+{
+    point_t dir  = { 0 };
+    int     last = (int)game_size - 1;
+
+    if ((0 == pos.x) && (0 < pos.y))
+    {
+        dir.y = -1;
+    }
+    else if (0 == (pos.y % 2))
+    {
+        dir.x = (last == pos.x) ? 0 : 1;
+        dir.y = (last == pos.x) ? 1 : 0;
+    }
+    else if ((last == pos.y) || (1 < pos.x))
+    {
+        dir.x = -1;
+    }
+    else
+    {
+        dir.y = 1;
+    }
+
+    return dir;
+}
+
+static void bench_game_tick (size_t game_size, size_t length)
+{
+    bench_t  bench  = { 0 };
+    game_t * p_game = game_init(game_size, game_size, BENCH_SEED);
+
+    if (NULL == p_game)
+    {
+        goto EXIT;
+    }
+
+    // grow untimed, following the cycle so the snake cannot die
+    while ((game_get_length(p_game) < length) && !game_is_over(p_game))
+    {
+        game_step(p_game,
+                  bench_cycle_dir(game_get_head(p_game), game_size));
+    }
+
+    size_t ticks = 0;
+
+    bench_start(&bench);
+
+    for (; ticks < BENCH_TICKS; ticks++)
+    {
+        game_turn_player(p_game,
+                         bench_cycle_dir(game_get_head(p_game), game_size));
+
+        if (!game_tick(p_game))
+        {
+            break;
+        }
+    }
+
+    char name[48] = { 0 };
+
+    (void)snprintf(name, sizeof(name), "game_tick_len_%zu", length);
+    bench_stop(&bench, name, game_size, (0 == ticks) ? 1 : ticks);
+    game_destroy(&p_game);
+
+EXIT:
+    return;
+}
+
+/**
+ * @brief Takes and restores snapshots of a game with a grown snake
+ */
+static void bench_snapshot (size_t game_size)
+{
+    bench_t  bench  = { 0 };
+    game_t * p_game = game_init(game_size, game_size, BENCH_SEED);
+    size_t   size   = game_snapshot_size(p_game);
+    void *   p_buf  = malloc(size);
+
+    if ((NULL == p_game) || (NULL == p_buf))
+    {
+        goto EXIT;
+    }
+
+    while ((game_get_length(p_game) < (game_size * 2)) && !game_is_over(p_game))
+    {
+        game_step(p_game,
+                  bench_cycle_dir(game_get_head(p_game), game_size));
+    }
+
+    bench_start(&bench);
+
+    for (size_t idx = 0; idx < BENCH_SNAPSHOTS; idx++)
+    {
+        g_sink += (uintptr_t)game_snapshot(p_game, p_buf, size);
+    }
+
+    bench_stop(&bench, "game_snapshot", game_size, BENCH_SNAPSHOTS);
+    bench_start(&bench);
+
+    for (size_t idx = 0; idx < BENCH_SNAPSHOTS; idx++)
+    {
+        g_sink += (uintptr_t)game_restore(p_game, p_buf, size);
+    }
+
+    bench_stop(&bench, "game_restore", game_size, BENCH_SNAPSHOTS);
+
+EXIT:
+    free(p_buf);
+    game_destroy(&p_game);
+}
+
+/**
+ * @brief Steps many small games one at a time and then as one vecenv_t
+ *
+ * @note Both follow the same cycle, so the two rows do the same game work and
+ * differ only in layout and in the vectorized move and food checks.
+ */
+static void bench_vecenv (size_t count)
+{
+    bench_t    bench    = { 0 };
+    game_t **  pp_games = calloc(count, sizeof(game_t *));
+    point_t *  p_dirs   = calloc(count, sizeof(point_t));
+    vecenv_t * p_env
+        = vecenv_create(count, BENCH_VEC_SIZE, BENCH_VEC_SIZE, BENCH_SEED);
+
+    if ((NULL == pp_games) || (NULL == p_dirs) || (NULL == p_env))
+    {
+        goto EXIT;
+    }
+
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        pp_games[idx]
+            = game_init(BENCH_VEC_SIZE, BENCH_VEC_SIZE, BENCH_SEED + idx);
+
+        if (NULL == pp_games[idx])
+        {
+            goto EXIT;
+        }
+    }
+
+    bench_start(&bench);
+
+    for (size_t step = 0; step < BENCH_STEPS; step++)
+    {
+        for (size_t idx = 0; idx < count; idx++)
+        {
+            game_t * p_game = pp_games[idx];
+
+            g_sink += game_step(
+                p_game,
+                bench_cycle_dir(game_get_head(p_game), BENCH_VEC_SIZE));
+        }
+    }
+
+    bench_stop(&bench, "game_step_many", count, BENCH_STEPS * count);
+    bench_start(&bench);
+
+    for (size_t step = 0; step < BENCH_STEPS; step++)
+    {
+        for (size_t idx = 0; idx < count; idx++)
+        {
+            point_t head = { .x = p_env->p_head_x[idx],
+                             .y = p_env->p_head_y[idx] };
+
+            p_dirs[idx] = bench_cycle_dir(head, BENCH_VEC_SIZE);
+        }
+
+        g_sink += vecenv_step(p_env, p_dirs);
+    }
+
+    bench_stop(&bench, "vecenv_step", count, BENCH_STEPS * count);
+
+EXIT:
+    for (size_t idx = 0; (NULL != pp_games) && (idx < count); idx++)
+    {
+        game_destroy(&pp_games[idx]);
+    }
+
+    vecenv_destroy(&p_env);
+    free(p_dirs);
+    free(pp_games);
+}
+
+/**
+ * @brief Gets a mostly greedy direction with some random turns and no input
+ *
+ * @note Random enough to reach walls, self collisions and full boards.
+ */
+static point_t bench_check_dir (const game_t * p_game, rng_t * p_rng)
+{
+    static const point_t dirs[] = { { 1, 0 }, { 0, 1 }, { -1, 0 }, { 0, -1 } };
+
+    point_t  dir  = { 0 };
+    uint64_t roll = rng_below(p_rng, 10);
+
+    if (roll < 6)
+    {
+        dir = batch_policy_greedy(p_game, NULL);
+    }
+    else if (roll < 8)
+    {
+        dir = dirs[rng_below(p_rng, sizeof(dirs) / sizeof(dirs[0]))];
+    }
+
+    return dir;
+}
+
+/**
+ * @brief Plays the same games through game_t and vecenv_t and compares them
+ *
+ * @param width Width of every board
+ * @param height Height of every board
+ * @param b_use_avx2 Whether to let vecenv_t use its AVX2 kernel
+ * @retval true if every tile, score, length and over flag matched
+ * @retval false otherwise, the first difference is written to stderr
+ */
+static bool bench_check_vecenv (size_t width, size_t height, bool b_use_avx2)
+{
+    bool       b_is_match = false;
+    game_t *   p_games[BENCH_CHECK_GAMES] = { NULL };
+    point_t    dirs[BENCH_CHECK_GAMES]    = { { 0 } };
+    rng_t      rng                        = { { 0 } };
+    vecenv_t * p_env
+        = vecenv_create(BENCH_CHECK_GAMES, width, height, BENCH_SEED);
+
+    if (NULL == p_env)
+    {
+        goto EXIT;
+    }
+
+    p_env->b_use_avx2 = p_env->b_use_avx2 && b_use_avx2;
+    rng_seed(&rng, BENCH_SEED);
+
+    for (size_t idx = 0; idx < BENCH_CHECK_GAMES; idx++)
+    {
+        p_games[idx] = game_init(width, height, BENCH_SEED + idx);
+
+        if (NULL == p_games[idx])
+        {
+            goto EXIT;
+        }
+    }
+
+    for (size_t tick = 0; tick < BENCH_CHECK_TICKS; tick++)
+    {
+        for (size_t idx = 0; idx < BENCH_CHECK_GAMES; idx++)
+        {
+            dirs[idx] = bench_check_dir(p_games[idx], &rng);
+        }
+
+        (void)vecenv_step(p_env, dirs);
+
+        for (size_t idx = 0; idx < BENCH_CHECK_GAMES; idx++)
+        {
+            game_t * p_game = p_games[idx];
+
+            (void)game_step(p_game, dirs[idx]);
+
+            bool b_is_same
+                = (p_env->p_score[idx] == game_get_score(p_game))
+                  && ((size_t)p_env->p_length[idx] == game_get_length(p_game))
+                  && ((0 != p_env->p_is_over[idx]) == game_is_over(p_game));
+
+            for (size_t cell = 0; b_is_same && (cell < (width * height));
+                 cell++)
+            {
+                point_t pos = { .x = (int)(cell % width),
+                                .y = (int)(cell / width) };
+
+                b_is_same = (vecenv_get_tile(p_env, idx, pos)
+                             == game_get_tile(p_game, pos));
+            }
+
+            if (!b_is_same)
+            {
+                (void)fprintf(stderr,
+                              "vecenv differs from game_t on %zux%zu, "
+                              "game %zu, tick %zu, avx2 %d\n",
+                              width,
+                              height,
+                              idx,
+                              tick,
+                              (int)p_env->b_use_avx2);
+                goto EXIT;
+            }
+        }
+    }
+
+    b_is_match = true;
+
+EXIT:
+    for (size_t idx = 0; idx < BENCH_CHECK_GAMES; idx++)
+    {
+        game_destroy(&p_games[idx]);
+    }
+
+    vecenv_destroy(&p_env);
+    return b_is_match;
+}
+
+/**
+ * @brief Recomputes a game's Zobrist hash from scratch
+ */
+static uint64_t bench_full_hash (const game_t * p_game)
+{
+    point_t  head   = game_get_head(p_game);
+    size_t   width  = game_get_width(p_game);
+    size_t   height = game_get_height(p_game);
+    uint64_t hash   = zobrist_dir(game_get_dir(p_game))
+                     ^ zobrist_key(((size_t)head.y * width) + (size_t)head.x,
+                                   ZOBRIST_HEAD);
+
+    for (size_t cell = 0; cell < (width * height); cell++)
+    {
+        point_t       pos  = { .x = (int)(cell % width),
+                               .y = (int)(cell / width) };
+        entity_type_t type = game_get_tile(p_game, pos);
+
+        hash ^= (EMPTY == type) ? 0 : zobrist_key(cell, type);
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Checks the incremental hash against a recompute after every tick
+ *
+ * @retval true if they never differed
+ * @retval false otherwise, the first difference is written to stderr
+ */
+static bool bench_check_hash (size_t width, size_t height)
+{
+    bool  b_is_match = true;
+    rng_t rng        = { { 0 } };
+
+    rng_seed(&rng, BENCH_SEED);
+
+    for (size_t game_idx = 0; b_is_match && (game_idx < BENCH_CHECK_GAMES);
+         game_idx++)
+    {
+        game_t * p_game = game_init(width, height, BENCH_SEED + game_idx);
+
+        if (NULL == p_game)
+        {
+            b_is_match = false;
+            break;
+        }
+
+        for (size_t tick = 0; b_is_match && (tick < BENCH_CHECK_TICKS)
+                              && !game_is_over(p_game);
+             tick++)
+        {
+            (void)game_step(p_game, bench_check_dir(p_game, &rng));
+
+            if (bench_full_hash(p_game) != game_get_hash(p_game))
+            {
+                (void)fprintf(stderr,
+                              "Hash drifted on %zux%zu, game %zu, tick %zu\n",
+                              width,
+                              height,
+                              game_idx,
+                              tick);
+                b_is_match = false;
+            }
+        }
+
+        game_destroy(&p_game);
+    }
+
+    return b_is_match;
+}
+
+int main (void)
+{
+    size_t counts[]     = { 1000, 10000, 100000 };
+    size_t game_sizes[] = { 16, 64, 256, 1024 };
+    size_t lengths[]    = { 3, 64, 512 };
+    size_t env_counts[] = { 64, 1024, 16384 };
+    size_t snap_sizes[] = { 16, 64, 256 };
+
+    // from a full 3x1 row up to boards the greedy bot rarely fills
+    size_t check_sizes[][2]
+        = { { 3, 1 }, { 4, 4 }, { 7, 5 }, { 16, 16 }, { 33, 9 } };
+
+    for (size_t idx = 0; idx < (sizeof(check_sizes) / sizeof(check_sizes[0]));
+         idx++)
+    {
+        size_t width  = check_sizes[idx][0];
+        size_t height = check_sizes[idx][1];
+
+        if (!bench_check_vecenv(width, height, false)
+            || !bench_check_vecenv(width, height, true)
+            || !bench_check_hash(width, height))
+        {
+            return 1;
+        }
+    }
+
+    printf("bench,param,ops,ns_per_op,ops_per_sec,allocs_per_op\n");
+
+    for (size_t idx = 0; idx < (sizeof(counts) / sizeof(counts[0])); idx++)
+    {
+        bench_dyn_arr(counts[idx]);
+        bench_sll(counts[idx]);
+    }
+
+    for (size_t size_idx = 0;
+         size_idx < (sizeof(game_sizes) / sizeof(game_sizes[0]));
+         size_idx++)
+    {
+        for (size_t len_idx = 0;
+             len_idx < (sizeof(lengths) / sizeof(lengths[0]));
+             len_idx++)
+        {
+            size_t game_size = game_sizes[size_idx];
+
+            // leave room to keep ticking without filling the board
+            if (lengths[len_idx] <= ((game_size * game_size) / 2))
+            {
+                bench_game_tick(game_size, lengths[len_idx]);
+            }
+        }
+    }
+
+    for (size_t idx = 0; idx < (sizeof(snap_sizes) / sizeof(snap_sizes[0]));
+         idx++)
+    {
+        bench_snapshot(snap_sizes[idx]);
+    }
+
+    for (size_t idx = 0; idx < (sizeof(env_counts) / sizeof(env_counts[0]));
+         idx++)
+    {
+        bench_vecenv(env_counts[idx]);
+    }
+
+    return 0;
+}
+
+/*** end of file ***/
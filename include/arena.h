@@ -0,0 +1,80 @@
+/**
+ * @file arena.h
+ * @author Daniel Chung
+ * @brief Header file for bump allocated memory arena
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * An arena is one block of memory that allocations are carved from front to
+ * back. Nothing is freed on its own, the whole block is released at once by
+ * arena_destroy. The block comes from calloc, which hands large sizes
+ * straight to mmap and small ones to the heap, so tiny games do not pay for a
+ * fresh mapping each.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdalign.h>
+
+/**
+ * @brief Rounds a size up so the allocation after it stays aligned for any
+ * type
+ */
+#define ARENA_ALIGN(size)                                 \
+    (((size) + alignof(max_align_t) - 1)                  \
+     & ~((size_t)alignof(max_align_t) - 1))
+
+/**
+ * @brief Memory arena
+ *
+ * @note The arena header lives at the start of its own block.
+ *
+ * @param arena_t::p_base Start of the allocatable region
+ * @param arena_t::size Size of the allocatable region
+ * @param arena_t::used Count of bytes handed out
+ */
+typedef struct arena_t
+{
+    uint8_t * p_base;
+    size_t    size;
+    size_t    used;
+} arena_t;
+
+/**
+ * @brief Allocates a new arena
+ *
+ * @param size Count of bytes to make allocatable, sum ARENA_ALIGN of every
+ * allocation planned
+ * @retval arena_t* Pointer to arena on success
+ * @retval NULL on failure
+ */
+arena_t * arena_create (const size_t size);
+/**
+ * @brief Releases an arena and everything allocated from it
+ *
+ * @note Sets the pointer of arena to NULL after destruction.
+ *
+ * @param pp_arena Pointer to arena
+ */
+void arena_destroy (arena_t ** pp_arena);
+/**
+ * @brief Allocates zeroed memory from an arena
+ *
+ * @param p_arena Pointer to arena
+ * @param size Count of bytes
+ * @retval void* Pointer to memory on success
+ * @retval NULL if the arena is exhausted
+ */
+void * arena_alloc (arena_t * p_arena, const size_t size);
+
+#endif // ARENA_H
+
+/*** end of file ***/
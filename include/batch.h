@@ -0,0 +1,138 @@
+/**
+ * @file batch.h
+ * @author Daniel Chung
+ * @brief Headless batch runner playing many games across threads
+ * @version 0.1
+ * @date 2024-04-11
+ *
+ * Game i of a batch is seeded with base_seed + i, so a batch gives the same
+ * results whatever the thread count. Each worker starts with an even share
+ * of the game indices and, once it runs dry, steals the back half of the
+ * largest share left on another worker.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "game.h"
+
+#define BATCH_MAX_THREADS 256
+
+/**
+ * @brief Picks the direction for the next tick
+ *
+ * @note Called from worker threads, it must not touch shared state without
+ * its own locking. A zero direction keeps the current heading.
+ */
+typedef point_t (*batch_policy_f)(const game_t * p_game, void * p_ctx);
+
+/**
+ * @brief Enumeration for batch error codes
+ *
+ */
+typedef enum batch_error_t
+{
+    BATCH_GENERAL = -1,
+    BATCH_OK      = 0,
+    BATCH_NULL,
+    BATCH_INVALID,
+} batch_error_t;
+
+/**
+ * @brief What to run
+ *
+ * @param batch_config_t::width Width of every board
+ * @param batch_config_t::height Height of every board
+ * @param batch_config_t::base_seed Seed of game 0, game i gets base_seed + i
+ * @param batch_config_t::game_count Count of games, at most UINT32_MAX
+ * @param batch_config_t::thread_count Count of worker threads, 1 to
+ * BATCH_MAX_THREADS
+ * @param batch_config_t::max_ticks Games still running after this many ticks
+ * are stopped, 0 for no limit
+ * @param batch_config_t::policy Bot driving every game
+ * @param batch_config_t::p_policy_ctx Passed to every policy call
+ */
+typedef struct batch_config_t
+{
+    size_t         width;
+    size_t         height;
+    uint64_t       base_seed;
+    size_t         game_count;
+    size_t         thread_count;
+    size_t         max_ticks;
+    batch_policy_f policy;
+    void *         p_policy_ctx;
+} batch_config_t;
+
+/**
+ * @brief Outcome of one game
+ *
+ * @param batch_result_t::seed Seed the game was played with
+ * @param batch_result_t::score Final score
+ * @param batch_result_t::length Final length of the snake
+ * @param batch_result_t::ticks Count of ticks the snake moved
+ */
+typedef struct batch_result_t
+{
+    uint64_t seed;
+    int      score;
+    size_t   length;
+    size_t   ticks;
+} batch_result_t;
+
+/**
+ * @brief Totals over a batch
+ *
+ * @param batch_stats_t::games Count of games that ran
+ * @param batch_stats_t::total_score Sum of final scores
+ * @param batch_stats_t::max_score Best final score
+ * @param batch_stats_t::total_length Sum of final lengths
+ * @param batch_stats_t::max_length Longest final snake
+ * @param batch_stats_t::total_ticks Sum of ticks over every game
+ */
+typedef struct batch_stats_t
+{
+    size_t   games;
+    int64_t  total_score;
+    int      max_score;
+    uint64_t total_length;
+    size_t   max_length;
+    uint64_t total_ticks;
+} batch_stats_t;
+
+/**
+ * @brief Plays every game of a batch and waits for all of them
+ *
+ * @note The calling thread is worker 0. A worker thread that fails to start
+ * is reported on stderr and its share is stolen by the others.
+ *
+ * @param p_config Pointer to what to run
+ * @param p_results Receives game_count results indexed by game, can be NULL
+ * @param p_stats Receives the totals
+ * @retval BATCH_OK on success (0)
+ * @retval non-zero on failure
+ * @retval BATCH_NULL if p_config, its policy or p_stats is NULL
+ * @retval BATCH_INVALID if the counts are out of range
+ */
+int batch_run (const batch_config_t * p_config,
+               batch_result_t *       p_results,
+               batch_stats_t *        p_stats);
+/**
+ * @brief Heads for the closest food, avoiding moves that end the game
+ *
+ * @note A simple bot to evaluate against. p_ctx is unused.
+ */
+point_t batch_policy_greedy (const game_t * p_game, void * p_ctx);
+
+#endif // BATCH_H
+
+/*** end of file ***/
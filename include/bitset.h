@@ -0,0 +1,86 @@
+/**
+ * @file bitset.h
+ * @author Daniel Chung
+ * @brief Header file for fixed size bitset
+ * @version 0.1
+ * @date 2024-03-14
+ *
+ * The bit accessors are defined inline here since they sit on the per-tick hot
+ * path and compile down to a shift and a mask.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef BITSET_H
+#define BITSET_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BITSET_WORD_BITS 64
+#define BITSET_WORDS(size) (((size) + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS)
+
+/**
+ * @brief Fixed size bitset
+ *
+ * @param bitset_t::p_words Pointer to array of 64 bit words
+ * @param bitset_t::size Count of bits in the set
+ */
+typedef struct bitset_t
+{
+    uint64_t * p_words;
+    size_t     size;
+} bitset_t;
+
+/**
+ * @brief Initializes a bitset over caller owned words
+ *
+ * @note p_words must hold BITSET_WORDS(size) words and be zeroed. The caller
+ * releases the words.
+ *
+ * @param p_bitset Pointer to bitset
+ * @param p_words Pointer to word storage
+ * @param size Count of bits
+ */
+void bitset_init (bitset_t * p_bitset, uint64_t * p_words, const size_t size);
+
+/**
+ * @brief Sets a bit
+ *
+ * @note No bounds checking is done, idx must be less than size.
+ */
+static inline void bitset_set (bitset_t * p_bitset, const size_t idx)
+{
+    p_bitset->p_words[idx / BITSET_WORD_BITS]
+        |= (UINT64_C(1) << (idx % BITSET_WORD_BITS));
+}
+
+/**
+ * @brief Clears a bit
+ *
+ * @note No bounds checking is done, idx must be less than size.
+ */
+static inline void bitset_clear (bitset_t * p_bitset, const size_t idx)
+{
+    p_bitset->p_words[idx / BITSET_WORD_BITS]
+        &= ~(UINT64_C(1) << (idx % BITSET_WORD_BITS));
+}
+
+/**
+ * @brief Tests a bit
+ *
+ * @note No bounds checking is done, idx must be less than size.
+ */
+static inline bool bitset_test (const bitset_t * p_bitset, const size_t idx)
+{
+    return 0
+           != (p_bitset->p_words[idx / BITSET_WORD_BITS]
+               & (UINT64_C(1) << (idx % BITSET_WORD_BITS)));
+}
+
+#endif // BITSET_H
+
+/*** end of file ***/
@@ -0,0 +1,144 @@
+/**
+ * @file body.h
+ * @author Daniel Chung
+ * @brief Header file for the snake body ring buffer
+ * @version 0.1
+ * @date 2024-03-12
+ *
+ * The body is a contiguous ring of cells. The head index points at the most
+ * recently pushed cell and the tail index at the oldest one, so moving the
+ * snake is one push at the head and one pop at the tail, and growing is a push
+ * without a pop. An occupancy bitset over the board is kept in sync on every
+ * push and pop so checking whether a cell is covered is a single bit test.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef BODY_H
+#define BODY_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "point.h"
+#include "bitset.h"
+
+/**
+ * @brief Enumeration for body error codes
+ *
+ */
+typedef enum body_error_t
+{
+    BODY_GENERAL = -1,
+    BODY_OK      = 0,
+    BODY_NULL,
+    BODY_ALLOC,
+    BODY_FULL,
+    BODY_EMPTY,
+} body_error_t;
+
+/**
+ * @brief Snake body ring buffer
+ *
+ * @param body_t::p_cells Preallocated array of cells
+ * @param body_t::head Index of the head cell (most recently pushed)
+ * @param body_t::tail Index of the tail cell (oldest)
+ * @param body_t::length Count of cells in the body
+ * @param body_t::capacity Capacity of the cell array
+ * @param body_t::width Width of the board, used to index the occupancy bits
+ * @param body_t::height Height of the board
+ * @param body_t::p_occupied One bit per board cell, set while covered
+ */
+typedef struct body_t
+{
+    point_t *  p_cells;
+    size_t     head;
+    size_t     tail;
+    size_t     length;
+    size_t     capacity;
+    size_t     width;
+    size_t     height;
+    bitset_t * p_occupied;
+} body_t;
+
+/**
+ * @brief Initializes a body over caller owned storage
+ *
+ * @note The body can never be longer than the board, so width * height cells
+ * is all the storage it needs. The caller releases the storage.
+ *
+ * @param p_body Pointer to body
+ * @param p_cells Storage for width * height cells
+ * @param p_occupied Initialized bitset of width * height bits, all clear
+ * @param width Width of the board
+ * @param height Height of the board
+ */
+void body_init (body_t *     p_body,
+                point_t *    p_cells,
+                bitset_t *   p_occupied,
+                const size_t width,
+                const size_t height);
+/**
+ * @brief Pushes a new head cell onto the body
+ *
+ * @note pos must be on the board.
+ *
+ * @param p_body Pointer to body
+ * @param pos Position of the new head
+ * @retval BODY_OK on success (0)
+ * @retval BODY_NULL if p_body is NULL
+ * @retval BODY_FULL if the body is at capacity
+ */
+int body_push_head (body_t * p_body, point_t pos);
+/**
+ * @brief Pops the tail cell off the body
+ *
+ * @param p_body Pointer to body
+ * @param p_pos Receives the position of the released cell, can be NULL
+ * @retval BODY_OK on success (0)
+ * @retval BODY_NULL if p_body is NULL
+ * @retval BODY_EMPTY if the body is empty
+ */
+int body_pop_tail (body_t * p_body, point_t * p_pos);
+/**
+ * @brief Gets the head cell of the body
+ *
+ * @note The body must not be empty.
+ *
+ * @param p_body Pointer to body
+ * @return point_t Position of the head
+ */
+point_t body_head (const body_t * p_body);
+/**
+ * @brief Gets the tail cell of the body
+ *
+ * @note The body must not be empty.
+ *
+ * @param p_body Pointer to body
+ * @return point_t Position of the tail
+ */
+point_t body_tail (const body_t * p_body);
+/**
+ * @brief Gets the length of the body
+ *
+ * @param p_body Pointer to body
+ * @return size_t Count of cells in the body, 0 if p_body is NULL
+ */
+size_t body_length (const body_t * p_body);
+/**
+ * @brief Checks if a position is covered by the body
+ *
+ * @note Constant time, this is a single test of the occupancy bitset.
+ *
+ * @param p_body Pointer to body
+ * @param pos Position to check
+ * @retval true if a cell of the body is at pos
+ * @retval false otherwise, or if pos is off the board
+ */
+bool body_contains (const body_t * p_body, point_t pos);
+
+#endif // BODY_H
+
+/*** end of file ***/
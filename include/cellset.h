@@ -0,0 +1,121 @@
+/**
+ * @file cellset.h
+ * @author Daniel Chung
+ * @brief Header file for the set of board cells
+ * @version 0.1
+ * @date 2024-04-09
+ *
+ * A sparse set over cell ids. The members are packed at the front of a dense
+ * array, and a slot array maps each cell back to where it sits in the dense
+ * array. Adding, removing and testing a cell are all constant time, and a
+ * uniformly random member is just a random index into the dense array.
+ *
+ * The insert, remove and lookup functions are defined inline here since the
+ * game updates the set on every tick.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef CELLSET_H
+#define CELLSET_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define CELLSET_NONE UINT32_MAX
+
+/**
+ * @brief Sparse set of cell ids
+ *
+ * @param cellset_t::p_dense Members, in no particular order, first size used
+ * @param cellset_t::p_slots Index into p_dense of each cell, CELLSET_NONE if
+ * the cell is not a member
+ * @param cellset_t::size Count of members
+ * @param cellset_t::capacity Count of cells, ids run from 0 to capacity - 1
+ */
+typedef struct cellset_t
+{
+    uint32_t * p_dense;
+    uint32_t * p_slots;
+    size_t     size;
+    size_t     capacity;
+} cellset_t;
+
+/**
+ * @brief Initializes a set over caller owned storage, holding every cell
+ *
+ * @note p_dense and p_slots must each hold capacity entries, and capacity
+ * must be less than CELLSET_NONE.
+ *
+ * @param p_set Pointer to set
+ * @param p_dense Storage for the dense array
+ * @param p_slots Storage for the slot array
+ * @param capacity Count of cells
+ */
+void cellset_init (cellset_t *  p_set,
+                   uint32_t *   p_dense,
+                   uint32_t *   p_slots,
+                   const size_t capacity);
+
+/**
+ * @brief Checks if a cell is in the set
+ *
+ * @note No bounds checking is done, cell must be less than capacity.
+ */
+static inline bool cellset_contains (const cellset_t * p_set,
+                                     const size_t      cell)
+{
+    return CELLSET_NONE != p_set->p_slots[cell];
+}
+
+/**
+ * @brief Adds a cell to the set, does nothing if it is already in
+ *
+ * @note No bounds checking is done, cell must be less than capacity.
+ */
+static inline void cellset_insert (cellset_t * p_set, const size_t cell)
+{
+    if (!cellset_contains(p_set, cell))
+    {
+        p_set->p_dense[p_set->size] = (uint32_t)cell;
+        p_set->p_slots[cell]        = (uint32_t)p_set->size;
+        p_set->size++;
+    }
+}
+
+/**
+ * @brief Removes a cell from the set, does nothing if it is not in
+ *
+ * @note The last member moves into the hole, so this is constant time.
+ */
+static inline void cellset_remove (cellset_t * p_set, const size_t cell)
+{
+    uint32_t slot = p_set->p_slots[cell];
+
+    if (CELLSET_NONE != slot)
+    {
+        uint32_t last = p_set->p_dense[p_set->size - 1];
+
+        p_set->p_dense[slot] = last;
+        p_set->p_slots[last] = slot;
+        p_set->p_slots[cell] = CELLSET_NONE;
+        p_set->size--;
+    }
+}
+
+/**
+ * @brief Gets the member at an index of the dense array
+ *
+ * @note No bounds checking is done, idx must be less than size.
+ */
+static inline size_t cellset_at (const cellset_t * p_set, const size_t idx)
+{
+    return p_set->p_dense[idx];
+}
+
+#endif // CELLSET_H
+
+/*** end of file ***/
@@ -17,6 +17,7 @@
 #include <pthread.h>
 #include <limits.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 /**
  * @brief Enumeration for dynamic array constants
@@ -44,6 +45,15 @@ typedef enum dyn_arr_error_t
     DYN_ARR_RWLOCK,
 } dyn_arr_error_t;
 
+/**
+ * @brief Predicate for dyn_arr_remove_if
+ *
+ * @param p_data Element being tested
+ * @param p_ctx Caller context passed through from dyn_arr_remove_if
+ * @retval true if the element should be removed
+ */
+typedef bool (*dyn_arr_pred_f)(const void * p_data, void * p_ctx);
+
 /**
  * @brief Dynamic array structure
  *
@@ -52,6 +62,7 @@ typedef enum dyn_arr_error_t
  * @param dyn_arr_t::pp_arr Pointer to array of void pointers
  * @param dyn_arr_t::size Count of elements in array
  * @param dyn_arr_t::capacity Capacity of array
+ * @param dyn_arr_t::b_is_synced Whether calls take da_rwlock
  */
 typedef struct dyn_arr_t
 {
@@ -59,6 +70,7 @@ typedef struct dyn_arr_t
     size_t           size;
     size_t           capacity;
     pthread_rwlock_t da_rwlock;
+    bool             b_is_synced;
 } dyn_arr_t;
 
 /**
@@ -69,6 +81,17 @@ typedef struct dyn_arr_t
  * @retval NULL on failure
  */
 dyn_arr_t * dyn_arr_create (const size_t capacity);
+/**
+ * @brief Creates an unsynchronized dynamic array on heap
+ *
+ * @note Same API as a locked array, but no call takes the rwlock. Only use it
+ * from a single thread.
+ *
+ * @param capacity Initial capacity of the array
+ * @retval dyn_arr_t* Pointer to dynamic array on success
+ * @retval NULL on failure
+ */
+dyn_arr_t * dyn_arr_create_unsync (const size_t capacity);
 /**
  * @brief Destroys a dynamic array
  *
@@ -115,6 +138,37 @@ int dyn_arr_append (dyn_arr_t * p_dyn_arr, void * p_data);
  *
  */
 int dyn_arr_remove (dyn_arr_t * p_dyn_arr, const size_t index);
+/**
+ * @brief Removes a value by moving the last value into its slot
+ *
+ * @note Constant time, but does not keep the order of the array.
+ *
+ * @param p_dyn_arr Pointer to dynamic array
+ * @param index Index of value to remove
+ * @retval DYN_ARR_OK on success (0)
+ * @retval non-zero on failure
+ * @retval DYN_ARR_NULL if p_dyn_arr is NULL
+ * @retval DYN_ARR_BOUNDS if index is not less than the size
+ * @retval DYN_ARR_RWLOCK if failed to acquire or release write lock
+ */
+int dyn_arr_swap_remove (dyn_arr_t * p_dyn_arr, const size_t index);
+/**
+ * @brief Removes every value matching a predicate in one pass
+ *
+ * @note Kept values stay in order and slide down over the removed ones, so
+ * this is linear no matter how many are removed.
+ *
+ * @param p_dyn_arr Pointer to dynamic array
+ * @param should_remove Predicate selecting values to remove
+ * @param p_ctx Caller context passed to should_remove, can be NULL
+ * @retval DYN_ARR_OK on success (0)
+ * @retval non-zero on failure
+ * @retval DYN_ARR_NULL if p_dyn_arr or should_remove is NULL
+ * @retval DYN_ARR_RWLOCK if failed to acquire or release write lock
+ */
+int dyn_arr_remove_if (dyn_arr_t *    p_dyn_arr,
+                       dyn_arr_pred_f should_remove,
+                       void *         p_ctx);
 /**
  * @brief Gets a value from the dynamic array
  *
@@ -6,6 +6,10 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include "point.h"
+#include "vec.h"
+
+// score for eating one food, shared by game_tick and vecenv_step
+#define ENTITY_FOOD_SCORE 1
 
 typedef enum entity_type_t
 {
@@ -23,6 +27,15 @@ typedef struct entity_t
     bool          is_deletable;
 } entity_t;
 
-entity_t * entity_create (point_t pos, point_t dir, entity_type_t type);
+// entities held by value in one contiguous block, see vec.h
+VEC_DECLARE(entity_vec, entity_t)
+
+// fills in an entity the caller already owns, such as one in an entity_vec
+void entity_init (entity_t *    p_entity,
+                  point_t       pos,
+                  point_t       dir,
+                  entity_type_t type);
+// predicate for sweeping flagged entities out of an entity_vec
+bool entity_is_deletable (const entity_t * p_entity);
 
 #endif // ENTITY_H
\ No newline at end of file
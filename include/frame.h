@@ -0,0 +1,129 @@
+/**
+ * @file frame.h
+ * @author Daniel Chung
+ * @brief Header file for batched terminal frame buffer
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * Output for one frame is collected into a preallocated buffer and handed to
+ * the terminal with a single write() when the frame is flushed. The buffer
+ * tracks where the cursor will be so cursor moves to the cell right after the
+ * last one written are skipped.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+
+#define FRAME_GOTO_MAX 24
+
+/**
+ * @brief Enumeration for frame error codes
+ *
+ */
+typedef enum frame_error_t
+{
+    FRAME_GENERAL = -1,
+    FRAME_OK      = 0,
+    FRAME_NULL,
+    FRAME_ALLOC,
+    FRAME_WRITE,
+} frame_error_t;
+
+/**
+ * @brief Frame buffer
+ *
+ * @param frame_t::p_buf Preallocated output buffer
+ * @param frame_t::len Count of bytes pending in the buffer
+ * @param frame_t::capacity Capacity of the buffer
+ * @param frame_t::fd File descriptor the frame is written to
+ * @param frame_t::cursor_x Column the terminal cursor will be on, 0 if unknown
+ * @param frame_t::cursor_y Row the terminal cursor will be on, 0 if unknown
+ */
+typedef struct frame_t
+{
+    char * p_buf;
+    size_t len;
+    size_t capacity;
+    int    fd;
+    int    cursor_x;
+    int    cursor_y;
+} frame_t;
+
+/**
+ * @brief Creates a frame buffer on heap
+ *
+ * @param fd File descriptor to write frames to
+ * @param capacity Size of the buffer in bytes, a frame larger than this is
+ * written out in more than one write()
+ * @retval frame_t* Pointer to frame on success
+ * @retval NULL on failure
+ */
+frame_t * frame_create (int fd, size_t capacity);
+/**
+ * @brief Destroys a frame buffer without flushing it
+ *
+ * @note Sets the pointer of frame to NULL after destruction.
+ *
+ * @param pp_frame Pointer to frame
+ */
+void frame_destroy (frame_t ** pp_frame);
+/**
+ * @brief Moves the cursor, starting at 1 for both x and y
+ *
+ * @note Nothing is buffered if the cursor is already at x, y.
+ *
+ * @param p_frame Pointer to frame
+ * @param x Column
+ * @param y Row
+ * @retval FRAME_OK on success (0)
+ * @retval FRAME_NULL if p_frame is NULL
+ * @retval FRAME_WRITE if an early flush failed
+ */
+int frame_goto (frame_t * p_frame, int x, int y);
+/**
+ * @brief Buffers a string at the cursor
+ *
+ * @note The cursor is advanced by the byte length of p_str, so only single
+ * column characters keep the tracked cursor accurate. Use frame_forget_cursor
+ * after anything else.
+ *
+ * @param p_frame Pointer to frame
+ * @param p_str String to buffer
+ * @retval FRAME_OK on success (0)
+ * @retval FRAME_NULL if p_frame or p_str is NULL
+ * @retval FRAME_WRITE if an early flush failed
+ */
+int frame_puts (frame_t * p_frame, const char * p_str);
+/**
+ * @brief Marks the cursor position as unknown so the next frame_goto is
+ * always emitted
+ *
+ * @param p_frame Pointer to frame
+ */
+void frame_forget_cursor (frame_t * p_frame);
+/**
+ * @brief Writes every pending byte with a single write()
+ *
+ * @note Partial writes and interrupts are retried until the frame is out.
+ *
+ * @param p_frame Pointer to frame
+ * @retval FRAME_OK on success (0)
+ * @retval FRAME_NULL if p_frame is NULL
+ * @retval FRAME_WRITE if write() failed
+ */
+int frame_flush (frame_t * p_frame);
+
+#endif // FRAME_H
+
+/*** end of file ***/
@@ -1,3 +1,18 @@
+/**
+ * @file game.h
+ * @author Daniel Chung
+ * @brief Headless game core
+ * @version 0.1
+ * @date 2024-03-18
+ *
+ * Nothing in the core writes to the terminal. Front ends attach a
+ * game_renderer_t to be told about changes, and drive the game with
+ * game_step or game_turn_player plus game_tick.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
 #ifndef GAME_H
 #define GAME_H
 
@@ -5,44 +20,218 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdlib.h>
-#include <sys/time.h>
-#include "dyn_arr.h"
-#include "sll.h"
+#include <string.h>
+#include <time.h>
+#include "body.h"
+#include "tiles.h"
+#include "cellset.h"
+#include "rng.h"
+#include "zobrist.h"
+#include "arena.h"
 #include "entity.h"
 #include "point.h"
-#include "term.h"
-
-#define MAT_SIZE         11
-#define GAME_ICON_EMPTY  ". "
-#define GAME_ICON_PLAYER "[]"
-#define GAME_ICON_FOOD   "()"
-#define UPPER_LEFT       "┌"
-#define UPPER_RIGHT      "┐"
-#define LOWER_LEFT       "└"
-#define LOWER_RIGHT      "┘"
-#define HORIZONTAL       "──"
-#define VERTICAL         "│"
-#define OFFSET           2
-
-typedef struct game_tile_t
+#include "renderer.h"
+
+#define GAME_FOOD_COUNT 5
+// the snake starts three cells long along a row
+#define GAME_MIN_WIDTH  3
+#define GAME_MIN_HEIGHT 1
+#define GAME_MAX_SIZE   4096
+#define GAME_NO_ENTITY  UINT32_MAX
+
+/**
+ * @brief Enumeration for game error codes
+ *
+ */
+typedef enum game_error_t
 {
-    entity_type_t tile_type;
-} game_tile_t;
+    GAME_GENERAL = -1,
+    GAME_OK      = 0,
+    GAME_NULL,
+    GAME_SIZE,
+    GAME_MISMATCH,
+} game_error_t;
+
+/**
+ * @brief Scalar part of a snapshot
+ *
+ * @note In the snapshot buffer this is followed by a copy of the game's
+ * state block, the pointer free arrays at the end of its arena.
+ */
+typedef struct game_state_t
+{
+    size_t   width;
+    size_t   height;
+    size_t   state_size;
+    uint64_t seed;
+    rng_t    rng;
+    uint64_t hash;
+    point_t  dir;
+    int      score;
+    bool     is_over;
+    size_t   body_head;
+    size_t   body_tail;
+    size_t   body_length;
+    size_t   food_size;
+    size_t   empty_size;
+} game_state_t;
 
 typedef struct game_t
 {
-    dyn_arr_t *   p_entity_arr;
-    sll_t *       p_snake;
-    game_tile_t * p_tile_matrix;
-    size_t        game_size;
-    int           score;
+    arena_t *       p_arena;
+    entity_vec_t    food;
+    body_t *        p_body;
+    tiles_t         tiles;
+    cellset_t       empty_cells;
+    uint64_t        seed;
+    rng_t           rng;
+    uint64_t        hash;
+    uint8_t *       p_state;
+    size_t          state_size;
+    uint32_t *      p_food_index;
+    size_t          width;
+    size_t          height;
+    point_t         dir;
+    int             score;
+    bool            is_over;
+    game_renderer_t renderer;
 } game_t;
 
-game_t * game_init (size_t game_size);
-void     game_destroy (game_t ** pp_game);
-void     game_print_tiles (game_t * p_game);
-void     game_turn_player (game_t * p_game, point_t dir);
-bool     game_tick (game_t * p_game);
+/**
+ * @brief Creates a new game
+ *
+ * @note Everything the game owns, including the game_t itself, is laid out in
+ * a single arena allocation.
+ *
+ * @param width Width of the board, GAME_MIN_WIDTH to GAME_MAX_SIZE
+ * @param height Height of the board, GAME_MIN_HEIGHT to GAME_MAX_SIZE
+ * @param seed Seed for the game's own generator, the same seed and inputs
+ * always play out the same way
+ * @retval game_t* Pointer to game on success
+ * @retval NULL on failure
+ */
+game_t * game_init (size_t width, size_t height, uint64_t seed);
+/**
+ * @brief Destroys a game
+ *
+ * @note Releases the game's arena in one go. Sets the pointer of game to NULL
+ * after destruction.
+ *
+ * @param pp_game Pointer to game
+ */
+void game_destroy (game_t ** pp_game);
+/**
+ * @brief Attaches a renderer and replays the whole board through it
+ *
+ * @note Passing NULL detaches the renderer and makes the game headless.
+ *
+ * @param p_game Pointer to game
+ * @param p_renderer Pointer to renderer, copied into the game
+ */
+void game_set_renderer (game_t * p_game, const game_renderer_t * p_renderer);
+/**
+ * @brief Changes the direction of the snake for the next tick
+ *
+ * @note Turning back onto the snake itself is ignored.
+ *
+ * @param p_game Pointer to game
+ * @param dir New direction
+ */
+void game_turn_player (game_t * p_game, point_t dir);
+/**
+ * @brief Advances the game by one tick
+ *
+ * @param p_game Pointer to game
+ * @retval true if the snake moved
+ * @retval false if the game is over, including when this tick ended it
+ */
+bool game_tick (game_t * p_game);
+/**
+ * @brief Turns the snake and advances the game by one tick
+ *
+ * @note A zero direction keeps the current heading.
+ *
+ * @param p_game Pointer to game
+ * @param dir Input direction for this tick
+ * @retval true if the snake moved
+ * @retval false if the game is over
+ */
+bool game_step (game_t * p_game, point_t dir);
+/**
+ * @brief Checks if a position would end the game if the head moved there
+ *
+ * @note The tail cell is safe, the same as in game_tick, since the tail
+ * leaves it on the tick the head arrives.
+ *
+ * @param p_game Pointer to game
+ * @param pos Position to check
+ * @retval true if pos is off the board or covered by the snake past its tail
+ * @retval false otherwise
+ */
+bool game_is_colliding (const game_t * p_game, point_t pos);
+/**
+ * @brief Gets a 64 bit hash of the game state
+ *
+ * @note A Zobrist hash of the snake and food cells, the head and the heading,
+ * kept up to date as tiles change, so this is constant time. Games that hash
+ * the same are in the same state, barring a 1 in 2^64 collision.
+ *
+ * @param p_game Pointer to game
+ * @return uint64_t Hash of the state, 0 if p_game is NULL
+ */
+uint64_t game_get_hash (const game_t * p_game);
+/**
+ * @brief Gets the bytes a snapshot of a game takes
+ *
+ * @note Fixed for a board size, so one buffer serves every snapshot of a
+ * game.
+ *
+ * @param p_game Pointer to game
+ * @return size_t Size of a snapshot, 0 if p_game is NULL
+ */
+size_t game_snapshot_size (const game_t * p_game);
+/**
+ * @brief Copies the whole state of a game into a flat buffer
+ *
+ * @note The buffer holds no pointers, so it can be copied around freely and
+ * restored into any game of the same board size. The renderer is not part of
+ * the state.
+ *
+ * @param p_game Pointer to game
+ * @param p_buf Buffer of at least game_snapshot_size bytes, any alignment
+ * @param size Size of the buffer
+ * @retval GAME_OK on success (0)
+ * @retval GAME_NULL if p_game or p_buf is NULL
+ * @retval GAME_SIZE if the buffer is too small
+ */
+int game_snapshot (const game_t * p_game, void * p_buf, size_t size);
+/**
+ * @brief Puts a game back in the state of a snapshot
+ *
+ * @note An attached renderer is given the whole board again.
+ *
+ * @param p_game Pointer to game, with the board size of the snapshot
+ * @param p_buf Buffer filled by game_snapshot
+ * @param size Size of the buffer
+ * @retval GAME_OK on success (0)
+ * @retval GAME_NULL if p_game or p_buf is NULL
+ * @retval GAME_SIZE if the buffer is too small
+ * @retval GAME_MISMATCH if the snapshot is of another board size
+ */
+int game_restore (game_t * p_game, const void * p_buf, size_t size);
+
+entity_type_t game_get_tile (const game_t * p_game, point_t pos);
+size_t        game_get_width (const game_t * p_game);
+size_t        game_get_height (const game_t * p_game);
+uint64_t      game_get_seed (const game_t * p_game);
+int           game_get_score (const game_t * p_game);
+size_t        game_get_length (const game_t * p_game);
+point_t       game_get_head (const game_t * p_game);
+point_t       game_get_dir (const game_t * p_game);
+size_t        game_get_food_count (const game_t * p_game);
+// position of food idx, 0 to game_get_food_count - 1, in no particular order
+point_t       game_get_food (const game_t * p_game, size_t idx);
+bool          game_is_over (const game_t * p_game);
 
 #endif // GAME_H
 
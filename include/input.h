@@ -0,0 +1,101 @@
+/**
+ * @file input.h
+ * @author Daniel Chung
+ * @brief Header file for keyboard input parsing and queueing
+ * @version 0.1
+ * @date 2024-03-25
+ *
+ * Every byte waiting on the input descriptor is read when it becomes readable
+ * and fed through a small state machine that understands WASD and complete
+ * arrow key escape sequences, even when one is split across reads. Each
+ * direction pressed is pushed onto a bounded single producer single consumer
+ * queue, so quick turn combos are applied one per tick instead of being
+ * merged or lost.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include "point.h"
+
+// must be a power of two
+#define INPUT_QUEUE_SIZE 16
+#define INPUT_READ_SIZE  64
+#define INPUT_KEY_QUIT   3
+#define INPUT_KEY_ESC    27
+
+typedef enum movement_keys_t
+{
+    MOVEMENT_KEY_UP    = 119,
+    MOVEMENT_KEY_DOWN  = 115,
+    MOVEMENT_KEY_RIGHT = 100,
+    MOVEMENT_KEY_LEFT  = 97
+} movement_keys_t;
+
+typedef enum input_state_t
+{
+    INPUT_STATE_GROUND = 0,
+    INPUT_STATE_ESC,
+    INPUT_STATE_CSI,
+} input_state_t;
+
+/**
+ * @brief Input parser and direction queue
+ *
+ * @param input_t::fd Descriptor keys are read from
+ * @param input_t::state Escape sequence parser state, kept across reads
+ * @param input_t::b_should_quit Whether the quit key was read
+ * @param input_t::queue Ring of pending directions
+ * @param input_t::head Index of the next direction to pop, consumer owned
+ * @param input_t::tail Index of the next free slot, producer owned
+ */
+typedef struct input_t
+{
+    int            fd;
+    input_state_t  state;
+    bool           b_should_quit;
+    point_t        queue[INPUT_QUEUE_SIZE];
+    _Atomic size_t head;
+    _Atomic size_t tail;
+} input_t;
+
+/**
+ * @brief Initializes input for a descriptor
+ *
+ * @param p_input Pointer to input
+ * @param fd Descriptor to read keys from, should be non-blocking
+ */
+void input_init (input_t * p_input, int fd);
+/**
+ * @brief Reads and parses every byte currently waiting on the descriptor
+ *
+ * @note Directions that do not fit in the queue are dropped, as are repeats
+ * of the direction most recently queued.
+ *
+ * @param p_input Pointer to input
+ * @retval true if the quit key has been read
+ * @retval false otherwise
+ */
+bool input_read (input_t * p_input);
+/**
+ * @brief Pops the oldest queued direction
+ *
+ * @param p_input Pointer to input
+ * @param p_dir Receives the direction
+ * @retval true if a direction was popped
+ * @retval false if the queue is empty
+ */
+bool input_pop (input_t * p_input, point_t * p_dir);
+
+#endif // INPUT_H
+
+/*** end of file ***/
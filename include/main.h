@@ -6,19 +6,25 @@
 #include <signal.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <errno.h>
+#include <ctype.h>
 #include <sys/time.h>
 #include "term.h"
 #include "game.h"
+#include "term_renderer.h"
+#include "timestep.h"
+#include "input.h"
+#include "profile.h"
+#include "batch.h"
+#include "replay.h"
 
-typedef enum movement_keys_t
-{
-    MOVEMENT_KEY_UP    = 119,
-    MOVEMENT_KEY_DOWN  = 115,
-    MOVEMENT_KEY_RIGHT = 100,
-    MOVEMENT_KEY_LEFT  = 97
-} movement_keys_t;
-
-#define BOARD_SIZE 40
+#define DEFAULT_BOARD_WIDTH  20
+#define DEFAULT_BOARD_HEIGHT 20
+#define DEFAULT_TICK_RATE 10
+#define MAX_TICK_RATE     1000
+// batch games are cut off after this many ticks per board cell, so a bot
+// that circles forever cannot stall the batch
+#define BATCH_TICKS_PER_CELL 16
 
 #endif // MAIN_H
 
@@ -0,0 +1,108 @@
+/**
+ * @file profile.h
+ * @author Daniel Chung
+ * @brief Optional per phase tick profiler
+ * @version 0.1
+ * @date 2024-04-05
+ *
+ * Built only with -DPROFILE (`make profile`). Each phase wrapped in
+ * PROFILE_BEGIN/PROFILE_END is timed with CLOCK_MONOTONIC and recorded in a
+ * log-linear histogram, so p50, p99, p999 and max come out within about 6%
+ * without keeping every sample. Without PROFILE every macro here expands to
+ * nothing and the game carries no profiling code at all.
+ *
+ * Every thread records into its own set of histograms, made on its first
+ * sample, so batch workers can be profiled too. profile_dump merges the sets
+ * of every thread that has recorded so far.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @brief Phases that can be timed
+ *
+ * @note Phases nest, a tick's collide, move and spawn time is also in its
+ * tick time, and every place is also in whatever phase placed the tile.
+ * PROFILE_PLACE includes handing the tile to the renderer.
+ */
+typedef enum profile_phase_t
+{
+    PROFILE_INPUT = 0,
+    PROFILE_TICK,
+    PROFILE_COLLIDE,
+    PROFILE_MOVE,
+    PROFILE_SPAWN,
+    PROFILE_PLACE,
+    PROFILE_PRESENT,
+    PROFILE_FLUSH,
+    PROFILE_PHASE_COUNT,
+} profile_phase_t;
+
+#ifdef PROFILE
+
+// 16 sub-buckets per power of two, so each bucket is within 1/16 of its value
+#define PROFILE_SUB_BITS  4
+#define PROFILE_SUB_COUNT (1 << PROFILE_SUB_BITS)
+#define PROFILE_BUCKETS   ((64 - PROFILE_SUB_BITS + 1) * PROFILE_SUB_COUNT)
+
+#define PROFILE_BEGIN(phase) \
+    const uint64_t profile_start_##phase = profile_now()
+#define PROFILE_END(phase) \
+    profile_record((phase), profile_now() - profile_start_##phase)
+
+static inline uint64_t profile_now (void)
+{
+    struct timespec now = { 0 };
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Adds one sample to a phase's histogram
+ *
+ * @param phase Phase the sample belongs to
+ * @param nsec Duration of the sample in nanoseconds
+ */
+void profile_record (profile_phase_t phase, uint64_t nsec);
+/**
+ * @brief Writes count, p50, p99, p999 and max of every phase
+ *
+ * @param p_file Stream to write to
+ */
+void profile_dump (FILE * p_file);
+/**
+ * @brief Installs a SIGUSR1 handler that asks for a dump
+ *
+ * @note The dump itself happens on the next profile_poll, not in the handler.
+ */
+void profile_install (void);
+/**
+ * @brief Dumps if a SIGUSR1 arrived since the last poll
+ *
+ * @param p_file Stream to write to
+ */
+void profile_poll (FILE * p_file);
+
+#else
+
+#define PROFILE_BEGIN(phase) ((void)0)
+#define PROFILE_END(phase)   ((void)0)
+#define profile_dump(p_file) ((void)0)
+#define profile_install()    ((void)0)
+#define profile_poll(p_file) ((void)0)
+
+#endif // PROFILE
+
+#endif // PROFILE_H
+
+/*** end of file ***/
@@ -0,0 +1,46 @@
+/**
+ * @file renderer.h
+ * @author Daniel Chung
+ * @brief Renderer interface between the game core and a front end
+ * @version 0.1
+ * @date 2024-03-18
+ *
+ * The game core never writes output itself. A front end fills in a
+ * game_renderer_t and attaches it to a game, and the core calls back through
+ * it whenever a tile or the score changes. A game with no renderer attached
+ * runs headless.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include "entity.h"
+#include "point.h"
+
+typedef void (*renderer_draw_tile_f)(void *        p_ctx,
+                                     point_t       pos,
+                                     entity_type_t type);
+typedef void (*renderer_draw_score_f)(void * p_ctx, int score);
+
+/**
+ * @brief Renderer callbacks
+ *
+ * @note Any callback can be NULL to ignore that kind of change.
+ *
+ * @param game_renderer_t::p_ctx Front end state passed back to each callback
+ * @param game_renderer_t::draw_tile Called when a tile changes type
+ * @param game_renderer_t::draw_score Called when the score changes
+ */
+typedef struct game_renderer_t
+{
+    void *                p_ctx;
+    renderer_draw_tile_f  draw_tile;
+    renderer_draw_score_f draw_score;
+} game_renderer_t;
+
+#endif // RENDERER_H
+
+/*** end of file ***/
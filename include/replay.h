@@ -0,0 +1,175 @@
+/**
+ * @file replay.h
+ * @author Daniel Chung
+ * @brief Recording of a game's inputs and playing them back
+ * @version 0.1
+ * @date 2024-04-13
+ *
+ * A game is fully determined by its seed, its board size and the direction
+ * passed to game_step on every tick, so that is all a recording holds. The
+ * file is laid out as
+ *
+ *   header  "CSNR", version byte, seed as u64, width and height as u16
+ *   inputs  one varint per turn, (ticks since the last turn << 2) | dir
+ *   end     a 0 varint
+ *   footer  ticks and score as varints, state hash as u64
+ *
+ * Fixed width fields are little endian. Ticks without a turn cost nothing,
+ * and since the count since the last turn is at least 1 an input is never 0.
+ * Every input is flushed as it is recorded, so a session that crashes still
+ * leaves its inputs behind, just without a footer to check against.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "game.h"
+#include "point.h"
+
+#define REPLAY_MAGIC   "CSNR"
+#define REPLAY_VERSION 1
+
+/**
+ * @brief Enumeration for replay error codes
+ *
+ */
+typedef enum replay_error_t
+{
+    REPLAY_GENERAL = -1,
+    REPLAY_OK      = 0,
+    REPLAY_NULL,
+    REPLAY_IO,
+    REPLAY_FORMAT,
+    REPLAY_TRUNCATED,
+    REPLAY_MISMATCH,
+} replay_error_t;
+
+/**
+ * @brief An open recording, either being written or being played
+ *
+ * @param replay_t::p_file File the recording is in
+ * @param replay_t::b_is_writing Whether this records or plays
+ * @param replay_t::seed Seed of the recorded game
+ * @param replay_t::width Width of the recorded board
+ * @param replay_t::height Height of the recorded board
+ * @param replay_t::tick Count of ticks recorded or played so far
+ * @param replay_t::turn_tick Tick of the last turn written, plus one
+ * @param replay_t::next_tick When playing, tick of the next turn
+ * @param replay_t::next_dir When playing, direction of the next turn
+ * @param replay_t::b_has_next When playing, whether a turn is still ahead
+ * @param replay_t::b_has_footer When playing, whether the footer was read
+ * @param replay_t::b_is_corrupt When playing, whether a turn could not be read
+ * @param replay_t::ticks Ticks the recorded game ran for, from the footer
+ * @param replay_t::score Final score, from the footer
+ * @param replay_t::hash Final game_get_hash, from the footer
+ */
+typedef struct replay_t
+{
+    FILE *   p_file;
+    bool     b_is_writing;
+    uint64_t seed;
+    size_t   width;
+    size_t   height;
+    uint64_t tick;
+    uint64_t turn_tick;
+    uint64_t next_tick;
+    point_t  next_dir;
+    bool     b_has_next;
+    bool     b_has_footer;
+    bool     b_is_corrupt;
+    uint64_t ticks;
+    int      score;
+    uint64_t hash;
+} replay_t;
+
+/**
+ * @brief Starts recording a new game
+ *
+ * @note Call right after game_init, before the first tick.
+ *
+ * @param p_path Path of the file to write, replaced if it exists
+ * @param p_game Pointer to the game to record
+ * @retval replay_t* Pointer to recording on success
+ * @retval NULL on failure
+ */
+replay_t * replay_record_create (const char * p_path, const game_t * p_game);
+/**
+ * @brief Records the input of one tick
+ *
+ * @note Call once per game_step with the direction it was given.
+ *
+ * @param p_replay Pointer to recording
+ * @param dir Direction passed to game_step, zero for none
+ * @retval REPLAY_OK on success (0)
+ * @retval REPLAY_NULL if p_replay is NULL or not recording
+ * @retval REPLAY_FORMAT if dir is not zero or a unit step
+ * @retval REPLAY_IO if the write failed
+ */
+int replay_record (replay_t * p_replay, point_t dir);
+/**
+ * @brief Writes the end of the recording with the final state to check
+ *
+ * @param p_replay Pointer to recording
+ * @param p_game Pointer to the recorded game
+ * @retval REPLAY_OK on success (0)
+ * @retval REPLAY_NULL if an argument is NULL or p_replay is not recording
+ * @retval REPLAY_IO if the write failed
+ */
+int replay_finish (replay_t * p_replay, const game_t * p_game);
+/**
+ * @brief Opens a recording to play it back
+ *
+ * @note The seed and board size to create the game with are in the returned
+ * replay_t.
+ *
+ * @param p_path Path of the recording
+ * @retval replay_t* Pointer to recording on success
+ * @retval NULL if it cannot be read, is not a recording or has a board size
+ * game_init would refuse
+ */
+replay_t * replay_play_create (const char * p_path);
+/**
+ * @brief Gets the input of the next tick
+ *
+ * @param p_replay Pointer to recording being played
+ * @return point_t Direction to pass to game_step, zero for none
+ */
+point_t replay_next (replay_t * p_replay);
+/**
+ * @brief Checks if every recorded tick has been played
+ *
+ * @note A recording without a footer is done once its last turn is played.
+ */
+bool replay_is_done (const replay_t * p_replay);
+/**
+ * @brief Checks a played back game against the end of the recording
+ *
+ * @param p_replay Pointer to recording being played
+ * @param p_game Pointer to the game it was played into
+ * @retval REPLAY_OK if the ticks, score and state hash all match (0)
+ * @retval REPLAY_NULL if an argument is NULL or p_replay is not playing
+ * @retval REPLAY_FORMAT if the recording holds a turn that cannot be read
+ * @retval REPLAY_TRUNCATED if the recording has no footer to check
+ * @retval REPLAY_MISMATCH if the game ended up somewhere else
+ */
+int replay_verify (const replay_t * p_replay, const game_t * p_game);
+/**
+ * @brief Closes a recording
+ *
+ * @note Sets the pointer of recording to NULL after destruction. A recording
+ * closed before replay_finish has no footer.
+ *
+ * @param pp_replay Pointer to recording
+ */
+void replay_destroy (replay_t ** pp_replay);
+
+#endif // REPLAY_H
+
+/*** end of file ***/
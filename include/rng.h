@@ -0,0 +1,97 @@
+/**
+ * @file rng.h
+ * @author Daniel Chung
+ * @brief Seedable xoshiro256** pseudo random number generator
+ * @version 0.1
+ * @date 2024-04-10
+ *
+ * Every game owns one of these, so games never share random state and any run
+ * can be reproduced from its seed. The seed is expanded into the 256 bit
+ * state with splitmix64, as the xoshiro authors recommend, so any seed
+ * including 0 is fine.
+ *
+ * The generator is a handful of shifts and adds, so it is defined inline.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Generator state
+ *
+ * @note Plain data, copying it forks the sequence.
+ *
+ * @param rng_t::state xoshiro256** state words, never all zero
+ */
+typedef struct rng_t
+{
+    uint64_t state[4];
+} rng_t;
+
+/**
+ * @brief Seeds a generator
+ *
+ * @param p_rng Pointer to generator
+ * @param seed Any 64 bit value
+ */
+void rng_seed (rng_t * p_rng, uint64_t seed);
+
+static inline uint64_t rng_rotl (const uint64_t value, const int count)
+{
+    return (value << count) | (value >> (64 - count));
+}
+
+/**
+ * @brief Gets the next 64 random bits
+ */
+static inline uint64_t rng_next (rng_t * p_rng)
+{
+    uint64_t * p_s    = p_rng->state;
+    uint64_t   result = rng_rotl(p_s[1] * 5, 7) * 9;
+    uint64_t   t      = p_s[1] << 17;
+
+    p_s[2] ^= p_s[0];
+    p_s[3] ^= p_s[1];
+    p_s[1] ^= p_s[2];
+    p_s[0] ^= p_s[3];
+    p_s[2] ^= t;
+    p_s[3] = rng_rotl(p_s[3], 45);
+
+    return result;
+}
+
+/**
+ * @brief Gets a uniform random value from 0 to bound - 1
+ *
+ * @note Lemire's multiply and shift, rejecting the few values that would bias
+ * the result. bound must not be 0.
+ */
+static inline uint64_t rng_below (rng_t * p_rng, const uint64_t bound)
+{
+    __uint128_t product = (__uint128_t)rng_next(p_rng) * bound;
+    uint64_t    low     = (uint64_t)product;
+
+    if (low < bound)
+    {
+        uint64_t threshold = -bound % bound;
+
+        while (low < threshold)
+        {
+            product = (__uint128_t)rng_next(p_rng) * bound;
+            low     = (uint64_t)product;
+        }
+    }
+
+    return (uint64_t)(product >> 64);
+}
+
+#endif // RNG_H
+
+/*** end of file ***/
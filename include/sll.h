@@ -1,12 +1,20 @@
 /**
  * @file sll.h
  * @author Daniel Chung
- * @brief Threadsafe singly linked list
+ * @brief Threadsafe doubly linked list
  * @version 0.1
  * @date 2024-03-06
  *
  * Allows duplicates to be put in, not a set
  *
+ * Lists created unsynchronized keep the same API but never take the rwlock,
+ * for callers that only touch them from one thread.
+ *
+ * Nodes also link back to their predecessor, so adding or removing at either
+ * end is constant time. The sll_ names are kept from when it was singly
+ * linked. Callers walk the list with an sll_iter_t rather than following
+ * p_next themselves.
+ *
  * @copyright Copyright (c) 2024
  *
  */
@@ -24,6 +32,7 @@ typedef struct sll_node_t
 {
     void *              p_data;
     struct sll_node_t * p_next;
+    struct sll_node_t * p_prev;
 } sll_node_t;
 
 typedef int (*sll_cmp_f)(void *, void *);
@@ -35,6 +44,7 @@ typedef struct sll_t
     size_t           size;
     pthread_rwlock_t sll_rwlock;
     sll_cmp_f        node_cmp_func;
+    bool             b_is_synced;
     // int (*node_cmp_func)(void *, void *);
 } sll_t;
 
@@ -49,8 +59,22 @@ typedef enum sll_error_t
     SLL_RWLOCK,
 } sll_error_t;
 
+/**
+ * @brief Position in a list, from sll_iter_begin or sll_iter_rbegin
+ *
+ * @note Iterating does not take the lock. Nothing may modify the list while
+ * an iterator over it is in use.
+ *
+ * @param sll_iter_t::p_node Current node, NULL once past either end
+ */
+typedef struct sll_iter_t
+{
+    sll_node_t * p_node;
+} sll_iter_t;
+
 // sll_t * sll_create (int (*cmp_func)(void *, void *));
 sll_t * sll_create (sll_cmp_f cmp_func);
+sll_t * sll_create_unsync (sll_cmp_f cmp_func);
 int     sll_destroy (sll_t ** pp_sll);
 int     sll_prepend (sll_t * p_sll, void * p_data, const bool b_is_locked);
 int     sll_append (sll_t * p_sll, void * p_data, const bool b_is_locked);
@@ -62,6 +86,38 @@ void *  sll_get (sll_t * p_sll, const size_t index);
 bool    sll_is_in (sll_t * p_sll, const void * p_data);
 bool    sll_is_empty (sll_t * p_sll);
 size_t  sll_size (sll_t * p_sll);
+void *  sll_peek_head (sll_t * p_sll);
+void *  sll_peek_tail (sll_t * p_sll);
+
+static inline sll_iter_t sll_iter_begin (const sll_t * p_sll)
+{
+    return (sll_iter_t) { .p_node = (NULL == p_sll) ? NULL : p_sll->p_head };
+}
+
+static inline sll_iter_t sll_iter_rbegin (const sll_t * p_sll)
+{
+    return (sll_iter_t) { .p_node = (NULL == p_sll) ? NULL : p_sll->p_tail };
+}
+
+static inline bool sll_iter_is_done (sll_iter_t iter)
+{
+    return NULL == iter.p_node;
+}
+
+static inline void * sll_iter_data (sll_iter_t iter)
+{
+    return (NULL == iter.p_node) ? NULL : iter.p_node->p_data;
+}
+
+static inline void sll_iter_next (sll_iter_t * p_iter)
+{
+    p_iter->p_node = p_iter->p_node->p_next;
+}
+
+static inline void sll_iter_prev (sll_iter_t * p_iter)
+{
+    p_iter->p_node = p_iter->p_node->p_prev;
+}
 
 #endif // SLL_H
 
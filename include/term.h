@@ -5,6 +5,10 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <fcntl.h>
+#include <sys/ioctl.h>
+
+#define TERM_DEFAULT_COLS 80
+#define TERM_DEFAULT_ROWS 24
 
 /**
  * @brief Sets the terminal to raw mode and sets to non-blocking mode.
@@ -37,6 +41,17 @@ void term_hide_cursor(void);
 
 void term_show_cursor(void);
 
+/**
+ * @brief Gets the size of the terminal on stdout
+ *
+ * @note Falls back to TERM_DEFAULT_COLS by TERM_DEFAULT_ROWS when stdout is
+ * not a terminal.
+ *
+ * @param p_cols Receives the count of columns
+ * @param p_rows Receives the count of rows
+ */
+void term_get_size (int * p_cols, int * p_rows);
+
 #endif // TERM_H
 
 /*** end of file ***/
\ No newline at end of file
@@ -0,0 +1,131 @@
+/**
+ * @file term_renderer.h
+ * @author Daniel Chung
+ * @brief Terminal front end for the game renderer interface
+ * @version 0.1
+ * @date 2024-03-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TERM_RENDERER_H
+#define TERM_RENDERER_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "game.h"
+#include "renderer.h"
+#include "term.h"
+#include "frame.h"
+
+#define GAME_ICON_EMPTY  ". "
+#define GAME_ICON_PLAYER "[]"
+#define GAME_ICON_FOOD   "()"
+#define OFFSET           2
+// unchanged cells this close together are rewritten instead of jumped over
+#define TERM_RUN_GAP     2
+// rows under the board kept for the blank line and the score
+#define TERM_STATUS_ROWS 2
+
+/**
+ * @brief Terminal renderer state
+ *
+ * The back buffer takes tile changes from the game core as they happen. The
+ * front buffer holds what is on screen, and presenting a frame only writes
+ * the cells where the two differ.
+ *
+ * Only the part of the board inside the view is drawn. The view is as big as
+ * the terminal allows and scrolls to keep whatever term_renderer_follow was
+ * last given in sight.
+ *
+ * @param term_renderer_t::renderer Interface to attach to a game, its context
+ * points back at this struct
+ * @param term_renderer_t::width Width of the board being drawn
+ * @param term_renderer_t::height Height of the board being drawn
+ * @param term_renderer_t::view_x Leftmost board column on screen
+ * @param term_renderer_t::view_y Topmost board row on screen
+ * @param term_renderer_t::view_width Count of board columns on screen
+ * @param term_renderer_t::view_height Count of board rows on screen
+ * @param term_renderer_t::p_frame Buffer collecting the output of one frame
+ * @param term_renderer_t::p_back Tile types the next frame should show
+ * @param term_renderer_t::p_front Tile types currently on screen
+ * @param term_renderer_t::back_score Score the next frame should show
+ * @param term_renderer_t::front_score Score currently on screen
+ * @param term_renderer_t::b_is_stale Whether the screen is unknown and the
+ * next frame must redraw everything
+ */
+typedef struct term_renderer_t
+{
+    game_renderer_t renderer;
+    size_t          width;
+    size_t          height;
+    size_t          view_x;
+    size_t          view_y;
+    size_t          view_width;
+    size_t          view_height;
+    frame_t *       p_frame;
+    uint8_t *       p_back;
+    uint8_t *       p_front;
+    int             back_score;
+    int             front_score;
+    bool            b_is_stale;
+} term_renderer_t;
+
+/**
+ * @brief Creates a terminal renderer on heap
+ *
+ * @note The first frame presented is a full redraw.
+ *
+ * @param width Width of the board being drawn
+ * @param height Height of the board being drawn
+ * @retval term_renderer_t* Pointer to renderer on success
+ * @retval NULL on failure
+ */
+term_renderer_t * term_renderer_create (size_t width, size_t height);
+/**
+ * @brief Destroys a terminal renderer
+ *
+ * @note Sets the pointer of renderer to NULL after destruction.
+ *
+ * @param pp_term Pointer to renderer
+ */
+void term_renderer_destroy (term_renderer_t ** pp_term);
+/**
+ * @brief Writes the cells that changed since the last frame to the terminal
+ *
+ * @note This is one write() for the whole frame. Changed cells on the same
+ * row are grouped into runs so the cursor is only moved at the start of each
+ * run.
+ *
+ * @param p_term Pointer to renderer
+ * @retval FRAME_OK on success (0)
+ * @retval non-zero on failure
+ */
+int term_renderer_present (term_renderer_t * p_term);
+/**
+ * @brief Forgets what is on screen so the next frame clears and redraws
+ * everything
+ *
+ * @note Call after a resize or anything else that disturbs the terminal.
+ *
+ * @param p_term Pointer to renderer
+ */
+void term_renderer_invalidate (term_renderer_t * p_term);
+/**
+ * @brief Scrolls the view if a board position is near or past its edge
+ *
+ * @note The view recenters on pos, so it moves in jumps rather than every
+ * tick, and each jump is a full redraw.
+ *
+ * @param p_term Pointer to renderer
+ * @param pos Board position to keep in view, usually the snake's head
+ */
+void term_renderer_follow (term_renderer_t * p_term, point_t pos);
+
+#endif // TERM_RENDERER_H
+
+/*** end of file ***/
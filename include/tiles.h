@@ -0,0 +1,87 @@
+/**
+ * @file tiles.h
+ * @author Daniel Chung
+ * @brief Header file for the packed tile matrix
+ * @version 0.1
+ * @date 2024-04-08
+ *
+ * Each tile is an entity_type_t packed into TILES_BITS bits, TILES_PER_WORD
+ * to a 64 bit word, so a 4096 by 4096 board is 4 MiB instead of 64 MiB of
+ * enums. The accessors are defined inline here like the bitset ones, they
+ * are a shift and a mask.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TILES_H
+#define TILES_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "entity.h"
+
+#define TILES_BITS        2
+#define TILES_MASK        ((UINT64_C(1) << TILES_BITS) - 1)
+#define TILES_PER_WORD    (64 / TILES_BITS)
+#define TILES_WORDS(size) (((size) + TILES_PER_WORD - 1) / TILES_PER_WORD)
+
+_Static_assert(FOOD <= TILES_MASK, "entity types must fit in TILES_BITS");
+
+/**
+ * @brief Packed matrix of tile types
+ *
+ * @param tiles_t::p_words Pointer to array of 64 bit words
+ * @param tiles_t::size Count of tiles
+ */
+typedef struct tiles_t
+{
+    uint64_t * p_words;
+    size_t     size;
+} tiles_t;
+
+/**
+ * @brief Initializes tiles over caller owned words
+ *
+ * @note p_words must hold TILES_WORDS(size) words. Zeroed words are all EMPTY.
+ *
+ * @param p_tiles Pointer to tiles
+ * @param p_words Pointer to word storage
+ * @param size Count of tiles
+ */
+void tiles_init (tiles_t * p_tiles, uint64_t * p_words, const size_t size);
+
+/**
+ * @brief Sets the type of a tile
+ *
+ * @note No bounds checking is done, idx must be less than size.
+ */
+static inline void tiles_set (tiles_t *     p_tiles,
+                              const size_t  idx,
+                              entity_type_t type)
+{
+    uint64_t * p_word = &(p_tiles->p_words[idx / TILES_PER_WORD]);
+    unsigned   shift  = (unsigned)(idx % TILES_PER_WORD) * TILES_BITS;
+
+    *p_word = (*p_word & ~(TILES_MASK << shift))
+              | (((uint64_t)type & TILES_MASK) << shift);
+}
+
+/**
+ * @brief Gets the type of a tile
+ *
+ * @note No bounds checking is done, idx must be less than size.
+ */
+static inline entity_type_t tiles_get (const tiles_t * p_tiles,
+                                       const size_t    idx)
+{
+    unsigned shift = (unsigned)(idx % TILES_PER_WORD) * TILES_BITS;
+
+    return (entity_type_t)((p_tiles->p_words[idx / TILES_PER_WORD] >> shift)
+                           & TILES_MASK);
+}
+
+#endif // TILES_H
+
+/*** end of file ***/
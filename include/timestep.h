@@ -0,0 +1,80 @@
+/**
+ * @file timestep.h
+ * @author Daniel Chung
+ * @brief Header file for fixed timestep scheduling
+ * @version 0.1
+ * @date 2024-03-22
+ *
+ * Ticks are scheduled on CLOCK_MONOTONIC at a fixed period. Between ticks the
+ * caller sleeps in ppoll on an input descriptor, so input wakes it right away
+ * and an idle game uses no CPU.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TIMESTEP_H
+#define TIMESTEP_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <time.h>
+#include <poll.h>
+#include <signal.h>
+
+#define NSEC_PER_SEC        1000000000L
+// ticks further behind than this are dropped instead of replayed
+#define TIMESTEP_MAX_BEHIND 5
+
+/**
+ * @brief Fixed timestep schedule
+ *
+ * @param timestep_t::next_tick Monotonic time the next tick is due
+ * @param timestep_t::period_nsec Length of one tick in nanoseconds
+ */
+typedef struct timestep_t
+{
+    struct timespec next_tick;
+    int64_t         period_nsec;
+} timestep_t;
+
+/**
+ * @brief Starts a schedule with the first tick one period from now
+ *
+ * @param p_step Pointer to schedule
+ * @param tick_rate Ticks per second
+ * @retval 0 on success
+ * @retval -1 if p_step is NULL, tick_rate is 0 or the clock failed
+ */
+int timestep_init (timestep_t * p_step, uint32_t tick_rate);
+/**
+ * @brief Sleeps until the next tick is due or fd becomes readable
+ *
+ * @note Returns right away if a tick is already due. Signals interrupt the
+ * wait as well.
+ *
+ * @param p_step Pointer to schedule
+ * @param fd Descriptor to wake on, or -1 to only wait for the tick
+ * @retval true if fd is readable
+ * @retval false otherwise
+ */
+bool timestep_wait (timestep_t * p_step, int fd);
+/**
+ * @brief Consumes one due tick
+ *
+ * @note Call in a loop to catch up after a slow frame. When more than
+ * TIMESTEP_MAX_BEHIND ticks are due the backlog is dropped and the schedule
+ * restarts from now.
+ *
+ * @param p_step Pointer to schedule
+ * @retval true if a tick was due and the caller should run it
+ * @retval false if the next tick is still in the future
+ */
+bool timestep_is_due (timestep_t * p_step);
+
+#endif // TIMESTEP_H
+
+/*** end of file ***/
@@ -0,0 +1,235 @@
+/**
+ * @file vec.h
+ * @author Daniel Chung
+ * @brief Typed dynamic array that stores elements by value
+ * @version 0.1
+ * @date 2024-04-02
+ *
+ * VEC_DECLARE(name, type) generates a name_t array of type held inline in one
+ * contiguous block, along with static inline functions prefixed with name_.
+ * Iterating is a walk over p_items[0 .. size), removal swaps the last element
+ * into the hole, and growth doubles the block with realloc.
+ *
+ * A vec set up with name_init_fixed runs over caller owned storage, such as
+ * an arena, and fails with VEC_FULL instead of growing.
+ *
+ * @note Not threadsafe, callers must serialize access.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef VEC_H
+#define VEC_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define VEC_DEFAULT_CAP 8
+#define VEC_RESIZE      2
+
+/**
+ * @brief Enumeration for vec error codes
+ *
+ */
+typedef enum vec_error_t
+{
+    VEC_GENERAL = -1,
+    VEC_OK      = 0,
+    VEC_NULL,
+    VEC_ALLOC,
+    VEC_BOUNDS,
+    VEC_FULL,
+} vec_error_t;
+
+/**
+ * @brief Declares a typed vec and its functions
+ *
+ * Generates:
+ * - name_t with p_items, size, capacity and b_is_fixed
+ * - int name_init (name_t *, size_t capacity), heap storage
+ * - void name_init_fixed (name_t *, type * p_storage, size_t capacity)
+ * - void name_deinit (name_t *), frees heap storage only
+ * - int name_reserve (name_t *, size_t capacity)
+ * - int name_push (name_t *, type item)
+ * - type * name_at (name_t *, size_t index), NULL if out of bounds
+ * - int name_swap_remove (name_t *, size_t index)
+ * - size_t name_remove_if (name_t *, bool (*)(const type *)), stable single
+ *   pass compaction, returns the count removed
+ *
+ * Every int return is a vec_error_t.
+ */
+#define VEC_DECLARE(name, type)                                               \
+    typedef struct name##_t                                                   \
+    {                                                                         \
+        type * p_items;                                                       \
+        size_t size;                                                          \
+        size_t capacity;                                                      \
+        bool   b_is_fixed;                                                    \
+    } name##_t;                                                               \
+                                                                              \
+    static inline int name##_reserve (name##_t * p_vec, size_t capacity)      \
+    {                                                                         \
+        int status = VEC_OK;                                                  \
+                                                                              \
+        if (NULL == p_vec)                                                    \
+        {                                                                     \
+            status = VEC_NULL;                                                \
+        }                                                                     \
+        else if (capacity <= p_vec->capacity)                                 \
+        {                                                                     \
+            status = VEC_OK;                                                  \
+        }                                                                     \
+        else if (p_vec->b_is_fixed)                                           \
+        {                                                                     \
+            status = VEC_FULL;                                                \
+        }                                                                     \
+        else                                                                  \
+        {                                                                     \
+            type * p_items                                                    \
+                = (type *)realloc(p_vec->p_items, capacity * sizeof(type));   \
+                                                                              \
+            if (NULL == p_items)                                              \
+            {                                                                 \
+                perror("realloc");                                            \
+                status = VEC_ALLOC;                                           \
+            }                                                                 \
+            else                                                              \
+            {                                                                 \
+                p_vec->p_items  = p_items;                                    \
+                p_vec->capacity = capacity;                                   \
+            }                                                                 \
+        }                                                                     \
+                                                                              \
+        return status;                                                        \
+    }                                                                         \
+                                                                              \
+    static inline int name##_init (name##_t * p_vec, size_t capacity)         \
+    {                                                                         \
+        int status = VEC_NULL;                                                \
+                                                                              \
+        if (NULL != p_vec)                                                    \
+        {                                                                     \
+            p_vec->p_items    = NULL;                                         \
+            p_vec->size       = 0;                                            \
+            p_vec->capacity   = 0;                                            \
+            p_vec->b_is_fixed = false;                                        \
+            status            = name##_reserve(                               \
+                p_vec, (0 == capacity) ? VEC_DEFAULT_CAP : capacity);         \
+        }                                                                     \
+                                                                              \
+        return status;                                                        \
+    }                                                                         \
+                                                                              \
+    static inline void name##_init_fixed (                                    \
+        name##_t * p_vec, type * p_storage, size_t capacity)                  \
+    {                                                                         \
+        if (NULL != p_vec)                                                    \
+        {                                                                     \
+            p_vec->p_items    = p_storage;                                    \
+            p_vec->size       = 0;                                            \
+            p_vec->capacity   = capacity;                                     \
+            p_vec->b_is_fixed = true;                                         \
+        }                                                                     \
+    }                                                                         \
+                                                                              \
+    static inline void name##_deinit (name##_t * p_vec)                       \
+    {                                                                         \
+        if (NULL != p_vec)                                                    \
+        {                                                                     \
+            if (!p_vec->b_is_fixed)                                           \
+            {                                                                 \
+                free(p_vec->p_items);                                         \
+            }                                                                 \
+                                                                              \
+            p_vec->p_items  = NULL;                                           \
+            p_vec->size     = 0;                                              \
+            p_vec->capacity = 0;                                              \
+        }                                                                     \
+    }                                                                         \
+                                                                              \
+    static inline int name##_push (name##_t * p_vec, type item)               \
+    {                                                                         \
+        int status = VEC_NULL;                                                \
+                                                                              \
+        if (NULL != p_vec)                                                    \
+        {                                                                     \
+            status = VEC_OK;                                                  \
+                                                                              \
+            if (p_vec->size == p_vec->capacity)                               \
+            {                                                                 \
+                status = name##_reserve(                                      \
+                    p_vec,                                                    \
+                    (0 == p_vec->capacity) ? VEC_DEFAULT_CAP                  \
+                                           : p_vec->capacity * VEC_RESIZE);   \
+            }                                                                 \
+                                                                              \
+            if (VEC_OK == status)                                             \
+            {                                                                 \
+                p_vec->p_items[p_vec->size] = item;                           \
+                p_vec->size++;                                                \
+            }                                                                 \
+        }                                                                     \
+                                                                              \
+        return status;                                                        \
+    }                                                                         \
+                                                                              \
+    static inline type * name##_at (name##_t * p_vec, size_t index)           \
+    {                                                                         \
+        return ((NULL == p_vec) || (index >= p_vec->size))                    \
+                   ? NULL                                                     \
+                   : &(p_vec->p_items[index]);                                \
+    }                                                                         \
+                                                                              \
+    static inline int name##_swap_remove (name##_t * p_vec, size_t index)     \
+    {                                                                         \
+        int status = VEC_NULL;                                                \
+                                                                              \
+        if (NULL != p_vec)                                                    \
+        {                                                                     \
+            status = VEC_BOUNDS;                                              \
+                                                                              \
+            if (index < p_vec->size)                                          \
+            {                                                                 \
+                p_vec->size--;                                                \
+                p_vec->p_items[index] = p_vec->p_items[p_vec->size];          \
+                status                = VEC_OK;                               \
+            }                                                                 \
+        }                                                                     \
+                                                                              \
+        return status;                                                        \
+    }                                                                         \
+                                                                              \
+    static inline size_t name##_remove_if (                                   \
+        name##_t * p_vec, bool (*should_remove)(const type *))                \
+    {                                                                         \
+        size_t kept    = 0;                                                   \
+        size_t removed = 0;                                                   \
+                                                                              \
+        if ((NULL != p_vec) && (NULL != should_remove))                       \
+        {                                                                     \
+            for (size_t idx = 0; idx < p_vec->size; idx++)                    \
+            {                                                                 \
+                if (!should_remove(&(p_vec->p_items[idx])))                   \
+                {                                                             \
+                    if (kept != idx)                                          \
+                    {                                                         \
+                        p_vec->p_items[kept] = p_vec->p_items[idx];           \
+                    }                                                         \
+                                                                              \
+                    kept++;                                                   \
+                }                                                             \
+            }                                                                 \
+                                                                              \
+            removed     = p_vec->size - kept;                                 \
+            p_vec->size = kept;                                               \
+        }                                                                     \
+                                                                              \
+        return removed;                                                       \
+    }
+
+#endif // VEC_H
+
+/*** end of file ***/
@@ -0,0 +1,165 @@
+/**
+ * @file vecenv.h
+ * @author Daniel Chung
+ * @brief Many games of one board size stepped together
+ * @version 0.1
+ * @date 2024-04-12
+ *
+ * A vectorized environment for bots and training loops that step thousands of
+ * games in lockstep. The per game values the tick reads first (head, heading,
+ * tail cell, length, score, over flag) are stored as one array per field
+ * across games, so the move, bounds and food hit checks run over 8 games per
+ * instruction with AVX2. Only the games that moved then take the per game
+ * path that updates tiles, the body ring and the empty set.
+ *
+ * Game i starts from seed base_seed + i, and given the same directions plays
+ * out exactly like a game_t created with that seed.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef VECENV_H
+#define VECENV_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "arena.h"
+#include "tiles.h"
+#include "cellset.h"
+#include "rng.h"
+#include "entity.h"
+#include "point.h"
+
+/**
+ * @brief What a step did to a game
+ *
+ */
+typedef enum vecenv_event_t
+{
+    VECENV_IDLE = 0,
+    VECENV_MOVE,
+    VECENV_EAT,
+    VECENV_HIT_WALL,
+    VECENV_HIT_BODY,
+} vecenv_event_t;
+
+/**
+ * @brief A batch of games in struct of arrays layout
+ *
+ * @note Every p_ array below holds one entry per game. The int32_t ones are
+ * read by the step kernels and may be read directly between steps, but only
+ * changed through vecenv_step and vecenv_reset.
+ *
+ * @param vecenv_t::p_arena Arena everything below lives in
+ * @param vecenv_t::count Count of games
+ * @param vecenv_t::width Width of every board
+ * @param vecenv_t::height Height of every board
+ * @param vecenv_t::cells Count of cells on every board
+ * @param vecenv_t::tile_words Count of 64 bit tile words per game
+ * @param vecenv_t::p_head_x Column of each head
+ * @param vecenv_t::p_head_y Row of each head
+ * @param vecenv_t::p_dir_x Column step of each heading
+ * @param vecenv_t::p_dir_y Row step of each heading
+ * @param vecenv_t::p_tail_cell Cell of each tail, the head may move onto it
+ * @param vecenv_t::p_length Length of each snake
+ * @param vecenv_t::p_score Score of each game
+ * @param vecenv_t::p_is_over Non-zero once a game has ended
+ * @param vecenv_t::p_next_cell Scratch, cell each head moves to, -1 for none
+ * @param vecenv_t::p_event Scratch, vecenv_event_t of the last step
+ * @param vecenv_t::p_ring_head Index in its ring of each head cell
+ * @param vecenv_t::p_ring_tail Index in its ring of each tail cell
+ * @param vecenv_t::p_rings Body cells, cells entries per game
+ * @param vecenv_t::p_tile_words Packed tiles, tile_words words per game
+ * @param vecenv_t::p_empty Empty cells of each game
+ * @param vecenv_t::p_rngs Generator of each game
+ * @param vecenv_t::b_use_avx2 Whether the CPU runs the AVX2 kernel
+ */
+typedef struct vecenv_t
+{
+    arena_t *   p_arena;
+    size_t      count;
+    size_t      width;
+    size_t      height;
+    size_t      cells;
+    size_t      tile_words;
+    int32_t *   p_head_x;
+    int32_t *   p_head_y;
+    int32_t *   p_dir_x;
+    int32_t *   p_dir_y;
+    int32_t *   p_tail_cell;
+    int32_t *   p_length;
+    int32_t *   p_score;
+    int32_t *   p_is_over;
+    int32_t *   p_next_cell;
+    int32_t *   p_event;
+    uint32_t *  p_ring_head;
+    uint32_t *  p_ring_tail;
+    uint32_t *  p_rings;
+    uint64_t *  p_tile_words;
+    cellset_t * p_empty;
+    rng_t *     p_rngs;
+    bool        b_use_avx2;
+} vecenv_t;
+
+/**
+ * @brief Creates a batch of games
+ *
+ * @note Everything, including the vecenv_t itself, is laid out in a single
+ * arena allocation.
+ *
+ * @param count Count of games, at least 1
+ * @param width Width of every board, GAME_MIN_WIDTH to GAME_MAX_SIZE
+ * @param height Height of every board, GAME_MIN_HEIGHT to GAME_MAX_SIZE
+ * @param base_seed Seed of game 0, game i gets base_seed + i
+ * @retval vecenv_t* Pointer to batch on success
+ * @retval NULL on failure, including a batch too big to index with 32 bits
+ */
+vecenv_t * vecenv_create (size_t   count,
+                          size_t   width,
+                          size_t   height,
+                          uint64_t base_seed);
+/**
+ * @brief Destroys a batch
+ *
+ * @note Sets the pointer of batch to NULL after destruction.
+ *
+ * @param pp_env Pointer to batch
+ */
+void vecenv_destroy (vecenv_t ** pp_env);
+/**
+ * @brief Turns and advances every running game by one tick
+ *
+ * @note Turning follows game_turn_player, and a zero direction keeps the
+ * current heading. Games that are over are left alone until reset.
+ *
+ * @param p_env Pointer to batch
+ * @param p_dirs Input direction of each game, NULL to keep every heading
+ * @return size_t Count of games that moved
+ */
+size_t vecenv_step (vecenv_t * p_env, const point_t * p_dirs);
+/**
+ * @brief Starts a game over
+ *
+ * @note The game keeps drawing from its own generator, so a reset game does
+ * not replay the food of its last run.
+ *
+ * @param p_env Pointer to batch
+ * @param idx Index of the game
+ */
+void vecenv_reset (vecenv_t * p_env, size_t idx);
+/**
+ * @brief Gets the tile at a position of one game
+ *
+ * @param p_env Pointer to batch
+ * @param idx Index of the game
+ * @param pos Position on the board
+ * @return entity_type_t Tile type, EMPTY if idx or pos is out of range
+ */
+entity_type_t vecenv_get_tile (const vecenv_t * p_env, size_t idx, point_t pos);
+
+#endif // VECENV_H
+
+/*** end of file ***/
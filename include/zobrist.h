@@ -0,0 +1,64 @@
+/**
+ * @file zobrist.h
+ * @author Daniel Chung
+ * @brief Keys for incremental Zobrist hashing of a game
+ * @version 0.1
+ * @date 2024-04-14
+ *
+ * A Zobrist hash is the XOR of one random key per feature of the state, so a
+ * feature coming or going is a single XOR. Boards go up to 4096 by 4096, too
+ * big for a table of keys per cell, so each key is instead made on the spot
+ * by running the feature's id through the splitmix64 finalizer. That is a
+ * few multiplies and gives keys as good as a random table.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "point.h"
+
+/**
+ * @brief Kinds of feature, entity_type_t values are used for tiles
+ *
+ */
+typedef enum zobrist_kind_t
+{
+    ZOBRIST_HEAD = 4,
+    ZOBRIST_DIR,
+    ZOBRIST_KINDS = 8,
+} zobrist_kind_t;
+
+/**
+ * @brief Gets the key of a feature
+ *
+ * @param id Cell, or for ZOBRIST_DIR the heading from zobrist_dir
+ * @param kind Tile type or zobrist_kind_t
+ */
+static inline uint64_t zobrist_key (const uint64_t id, const uint64_t kind)
+{
+    uint64_t z = ((id * ZOBRIST_KINDS) + kind + 1) * UINT64_C(0x9E3779B97F4A7C15);
+
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Gets the key of a heading
+ */
+static inline uint64_t zobrist_dir (const point_t dir)
+{
+    return zobrist_key((uint64_t)(((dir.x + 1) * 3) + (dir.y + 1)),
+                       ZOBRIST_DIR);
+}
+
+#endif // ZOBRIST_H
+
+/*** end of file ***/
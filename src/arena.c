@@ -0,0 +1,75 @@
+/**
+ * @file arena.c
+ * @author Daniel Chung
+ * @brief Bump allocated memory arena implementation
+ * @version 0.1
+ * @date 2024-03-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/arena.h"
+
+arena_t * arena_create (const size_t size)
+{
+    arena_t * p_new_arena = NULL;
+    size_t    block_size  = ARENA_ALIGN(sizeof(arena_t)) + ARENA_ALIGN(size);
+
+    if (0 == size)
+    {
+        (void)fprintf(stderr, "Invalid arena size\n");
+        goto EXIT;
+    }
+
+    // the block comes back zeroed, so arena_alloc never has to clear
+    void * p_block = calloc(1, block_size);
+
+    if (NULL == p_block)
+    {
+        perror("malloc");
+        goto EXIT;
+    }
+
+    p_new_arena         = (arena_t *)p_block;
+    p_new_arena->p_base = (uint8_t *)p_block + ARENA_ALIGN(sizeof(arena_t));
+    p_new_arena->size   = ARENA_ALIGN(size);
+    p_new_arena->used   = 0;
+
+EXIT:
+    return p_new_arena;
+}
+
+
+void arena_destroy (arena_t ** pp_arena)
+{
+    if ((NULL == pp_arena) || (NULL == *pp_arena))
+    {
+        goto EXIT;
+    }
+
+    free(*pp_arena);
+    *pp_arena = NULL;
+
+EXIT:
+    return;
+}
+
+
+void * arena_alloc (arena_t * p_arena, const size_t size)
+{
+    void * p_mem = NULL;
+
+    if ((NULL == p_arena) || (ARENA_ALIGN(size) > p_arena->size - p_arena->used))
+    {
+        goto EXIT;
+    }
+
+    p_mem = p_arena->p_base + p_arena->used;
+    p_arena->used += ARENA_ALIGN(size);
+
+EXIT:
+    return p_mem;
+}
+
+/*** end of file ***/
@@ -0,0 +1,381 @@
+/**
+ * @file batch.c
+ * @author Daniel Chung
+ * @brief Headless batch runner playing many games across threads
+ * @version 0.1
+ * @date 2024-04-11
+ *
+ * Each worker's share is a range of game indices packed into one atomic
+ * word, begin in the high half and end in the low half. The owner takes games
+ * off the front and thieves cut off the back half, both with a single compare
+ * and swap on that word, so no locks are taken while the batch runs.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/batch.h"
+
+#include <stdalign.h>
+#include <string.h>
+
+#define BATCH_CACHE_LINE 64
+
+typedef struct batch_shared_t batch_shared_t;
+
+/**
+ * @brief State of one worker thread
+ *
+ * @note Aligned to a cache line so workers taking from their own range do not
+ * slow each other down.
+ *
+ * @param batch_worker_t::range Remaining game indices, see batch_pack
+ * @param batch_worker_t::thread Thread running the worker
+ * @param batch_worker_t::id Index of the worker
+ * @param batch_worker_t::p_shared State shared by every worker
+ * @param batch_worker_t::stats Totals over the games this worker played
+ */
+typedef struct batch_worker_t
+{
+    alignas(BATCH_CACHE_LINE) _Atomic uint64_t range;
+    pthread_t        thread;
+    size_t           id;
+    batch_shared_t * p_shared;
+    batch_stats_t    stats;
+} batch_worker_t;
+
+struct batch_shared_t
+{
+    const batch_config_t * p_config;
+    batch_result_t *       p_results;
+    batch_worker_t *       p_workers;
+    size_t                 worker_count;
+};
+
+static inline uint64_t batch_pack (uint32_t begin, uint32_t end)
+{
+    return ((uint64_t)begin << 32) | end;
+}
+
+static inline uint32_t batch_begin (uint64_t range)
+{
+    return (uint32_t)(range >> 32);
+}
+
+static inline uint32_t batch_end (uint64_t range)
+{
+    return (uint32_t)range;
+}
+
+/**
+ * @brief Takes the next game off the front of a worker's own range
+ *
+ * @param p_worker Pointer to worker
+ * @param p_idx Receives the game index
+ * @retval true if a game was taken
+ * @retval false if the range is empty
+ */
+static bool batch_take (batch_worker_t * p_worker, uint32_t * p_idx)
+{
+    bool     b_is_taken = false;
+    uint64_t range      = atomic_load(&p_worker->range);
+
+    while (batch_begin(range) < batch_end(range))
+    {
+        uint64_t taken = batch_pack(batch_begin(range) + 1, batch_end(range));
+
+        if (atomic_compare_exchange_weak(&p_worker->range, &range, taken))
+        {
+            *p_idx     = batch_begin(range);
+            b_is_taken = true;
+            break;
+        }
+    }
+
+    return (b_is_taken);
+}
+
+/**
+ * @brief Moves the back half of the fullest other range into this worker's
+ *
+ * @note Ranges only ever shrink, so once every range is empty the batch is
+ * done and there is nothing left to wait for.
+ *
+ * @param p_worker Pointer to the worker with an empty range
+ * @retval true if some games were stolen
+ * @retval false if every range is empty
+ */
+static bool batch_steal (batch_worker_t * p_worker)
+{
+    batch_shared_t * p_shared     = p_worker->p_shared;
+    bool             b_has_stolen = false;
+
+    while (!b_has_stolen)
+    {
+        batch_worker_t * p_victim  = NULL;
+        uint64_t         range     = 0;
+        uint32_t         remaining = 0;
+
+        for (size_t idx = 0; idx < p_shared->worker_count; idx++)
+        {
+            uint64_t other = atomic_load(&p_shared->p_workers[idx].range);
+            uint32_t left  = batch_end(other) - batch_begin(other);
+
+            if ((idx != p_worker->id) && (batch_begin(other) < batch_end(other))
+                && (left > remaining))
+            {
+                p_victim  = &p_shared->p_workers[idx];
+                range     = other;
+                remaining = left;
+            }
+        }
+
+        if (NULL == p_victim)
+        {
+            break;
+        }
+
+        // a single game left is taken whole
+        uint32_t mid = batch_begin(range) + (remaining / 2);
+
+        if (atomic_compare_exchange_strong(
+                &p_victim->range, &range, batch_pack(batch_begin(range), mid)))
+        {
+            atomic_store(&p_worker->range, batch_pack(mid, batch_end(range)));
+            b_has_stolen = true;
+        }
+    }
+
+    return (b_has_stolen);
+}
+
+static void batch_play (batch_worker_t * p_worker, uint32_t idx)
+{
+    const batch_config_t * p_config = p_worker->p_shared->p_config;
+    uint64_t               seed     = p_config->base_seed + idx;
+    game_t *               p_game
+        = game_init(p_config->width, p_config->height, seed);
+
+    if (NULL == p_game)
+    {
+        goto EXIT;
+    }
+
+    size_t ticks = 0;
+
+    while (!game_is_over(p_game)
+           && ((0 == p_config->max_ticks) || (ticks < p_config->max_ticks)))
+    {
+        point_t dir = p_config->policy(p_game, p_config->p_policy_ctx);
+
+        if (game_step(p_game, dir))
+        {
+            ticks++;
+        }
+    }
+
+    batch_result_t  result  = { .seed   = seed,
+                                .score  = game_get_score(p_game),
+                                .length = game_get_length(p_game),
+                                .ticks  = ticks };
+    batch_stats_t * p_stats = &p_worker->stats;
+
+    p_stats->games++;
+    p_stats->total_score += result.score;
+    p_stats->total_length += result.length;
+    p_stats->total_ticks += result.ticks;
+
+    if (result.score > p_stats->max_score)
+    {
+        p_stats->max_score = result.score;
+    }
+
+    if (result.length > p_stats->max_length)
+    {
+        p_stats->max_length = result.length;
+    }
+
+    if (NULL != p_worker->p_shared->p_results)
+    {
+        p_worker->p_shared->p_results[idx] = result;
+    }
+
+    game_destroy(&p_game);
+
+EXIT:
+    return;
+}
+
+static void * batch_work (void * p_arg)
+{
+    batch_worker_t * p_worker = (batch_worker_t *)p_arg;
+    uint32_t         idx      = 0;
+
+    do
+    {
+        while (batch_take(p_worker, &idx))
+        {
+            batch_play(p_worker, idx);
+        }
+    } while (batch_steal(p_worker));
+
+    return NULL;
+}
+
+int batch_run (const batch_config_t * p_config,
+               batch_result_t *       p_results,
+               batch_stats_t *        p_stats)
+{
+    int              status    = BATCH_GENERAL;
+    batch_worker_t * p_workers = NULL;
+
+    if ((NULL == p_config) || (NULL == p_config->policy) || (NULL == p_stats))
+    {
+        (void)fprintf(stderr, "Invalid arguments\n");
+        status = BATCH_NULL;
+        goto EXIT;
+    }
+
+    size_t workers = p_config->thread_count;
+    size_t games   = p_config->game_count;
+
+    if ((0 == workers) || (BATCH_MAX_THREADS < workers)
+        || (UINT32_MAX < games))
+    {
+        (void)fprintf(stderr, "Invalid thread or game count\n");
+        status = BATCH_INVALID;
+        goto EXIT;
+    }
+
+    p_workers = (batch_worker_t *)aligned_alloc(
+        BATCH_CACHE_LINE, workers * sizeof(batch_worker_t));
+
+    if (NULL == p_workers)
+    {
+        perror("aligned_alloc");
+        status = BATCH_GENERAL;
+        goto EXIT;
+    }
+
+    (void)memset(p_workers, 0, workers * sizeof(batch_worker_t));
+
+    batch_shared_t shared = { .p_config     = p_config,
+                              .p_results    = p_results,
+                              .p_workers    = p_workers,
+                              .worker_count = workers };
+    uint32_t       begin  = 0;
+
+    // even shares up front, stealing evens out the rest
+    for (size_t idx = 0; idx < workers; idx++)
+    {
+        uint32_t share = (uint32_t)((games / workers)
+                                    + ((idx < (games % workers)) ? 1 : 0));
+
+        p_workers[idx].id       = idx;
+        p_workers[idx].p_shared = &shared;
+        atomic_init(&p_workers[idx].range, batch_pack(begin, begin + share));
+        begin += share;
+    }
+
+    // worker 0 runs on this thread. If a thread fails to start, the others
+    // steal its share, so the batch still completes.
+    bool b_is_started[BATCH_MAX_THREADS] = { false };
+
+    for (size_t idx = 1; idx < workers; idx++)
+    {
+        b_is_started[idx] = (0
+                             == pthread_create(&p_workers[idx].thread,
+                                               NULL,
+                                               batch_work,
+                                               &p_workers[idx]));
+
+        if (!b_is_started[idx])
+        {
+            (void)fprintf(stderr, "Failed to start worker %zu\n", idx);
+        }
+    }
+
+    (void)batch_work(&p_workers[0]);
+    *p_stats = (batch_stats_t) { 0 };
+
+    for (size_t idx = 0; idx < workers; idx++)
+    {
+        if (b_is_started[idx])
+        {
+            (void)pthread_join(p_workers[idx].thread, NULL);
+        }
+
+        batch_stats_t * p_worker_stats = &p_workers[idx].stats;
+
+        p_stats->games += p_worker_stats->games;
+        p_stats->total_score += p_worker_stats->total_score;
+        p_stats->total_length += p_worker_stats->total_length;
+        p_stats->total_ticks += p_worker_stats->total_ticks;
+
+        if (p_worker_stats->max_score > p_stats->max_score)
+        {
+            p_stats->max_score = p_worker_stats->max_score;
+        }
+
+        if (p_worker_stats->max_length > p_stats->max_length)
+        {
+            p_stats->max_length = p_worker_stats->max_length;
+        }
+    }
+
+    free(p_workers);
+    status = BATCH_OK;
+
+EXIT:
+    return status;
+}
+
+point_t batch_policy_greedy (const game_t * p_game, void * p_ctx)
+{
+    static const point_t dirs[] = { { 1, 0 }, { 0, 1 }, { -1, 0 }, { 0, -1 } };
+
+    (void)p_ctx;
+
+    point_t  head       = game_get_head(p_game);
+    point_t  heading    = game_get_dir(p_game);
+    size_t   food_count = game_get_food_count(p_game);
+    point_t  best_dir   = { 0 };
+    uint64_t best_dist  = UINT64_MAX;
+
+    for (size_t dir_idx = 0; dir_idx < (sizeof(dirs) / sizeof(dirs[0]));
+         dir_idx++)
+    {
+        point_t dir  = dirs[dir_idx];
+        point_t next = { .x = head.x + dir.x, .y = head.y + dir.y };
+
+        if (((dir.x == -heading.x) && (dir.y == -heading.y))
+            || game_is_colliding(p_game, next))
+        {
+            continue;
+        }
+
+        uint64_t dist = (0 == food_count) ? 0 : UINT64_MAX;
+
+        for (size_t food_idx = 0; food_idx < food_count; food_idx++)
+        {
+            point_t  food = game_get_food(p_game, food_idx);
+            uint64_t food_dist
+                = (uint64_t)abs(food.x - next.x) + (uint64_t)abs(food.y - next.y);
+
+            if (food_dist < dist)
+            {
+                dist = food_dist;
+            }
+        }
+
+        if (dist < best_dist)
+        {
+            best_dist = dist;
+            best_dir  = dir;
+        }
+    }
+
+    return best_dir;
+}
+
+/*** end of file ***/
@@ -0,0 +1,23 @@
+/**
+ * @file bitset.c
+ * @author Daniel Chung
+ * @brief Fixed size bitset implementation
+ * @version 0.1
+ * @date 2024-03-14
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/bitset.h"
+
+void bitset_init (bitset_t * p_bitset, uint64_t * p_words, const size_t size)
+{
+    if (NULL != p_bitset)
+    {
+        p_bitset->p_words = p_words;
+        p_bitset->size    = size;
+    }
+}
+
+/*** end of file ***/
@@ -0,0 +1,150 @@
+/**
+ * @file body.c
+ * @author Daniel Chung
+ * @brief Snake body ring buffer implementation
+ * @version 0.1
+ * @date 2024-03-12
+ *
+ * The cell array is set up once by body_init and never resized. Indices wrap
+ * around the end of the array, so neither end of the body ever shifts.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/body.h"
+
+void body_init (body_t *     p_body,
+                point_t *    p_cells,
+                bitset_t *   p_occupied,
+                const size_t width,
+                const size_t height)
+{
+    if (NULL == p_body)
+    {
+        goto EXIT;
+    }
+
+    p_body->p_cells    = p_cells;
+    p_body->p_occupied = p_occupied;
+    p_body->width      = width;
+    p_body->height     = height;
+    p_body->capacity   = width * height;
+    p_body->length     = 0;
+    p_body->tail       = 0;
+    // head sits one behind tail so the first push lands on index 0
+    p_body->head       = p_body->capacity - 1;
+
+EXIT:
+    return;
+}
+
+
+int body_push_head (body_t * p_body, point_t pos)
+{
+    int status = BODY_GENERAL;
+
+    if (NULL == p_body)
+    {
+        status = BODY_NULL;
+        goto EXIT;
+    }
+
+    if (p_body->capacity == p_body->length)
+    {
+        status = BODY_FULL;
+        goto EXIT;
+    }
+
+    p_body->head++;
+
+    if (p_body->capacity == p_body->head)
+    {
+        p_body->head = 0;
+    }
+
+    p_body->p_cells[p_body->head] = pos;
+    bitset_set(p_body->p_occupied, (pos.y * p_body->width) + pos.x);
+    p_body->length++;
+    status = BODY_OK;
+
+EXIT:
+    return status;
+}
+
+
+int body_pop_tail (body_t * p_body, point_t * p_pos)
+{
+    int status = BODY_GENERAL;
+
+    if (NULL == p_body)
+    {
+        status = BODY_NULL;
+        goto EXIT;
+    }
+
+    if (0 == p_body->length)
+    {
+        status = BODY_EMPTY;
+        goto EXIT;
+    }
+
+    point_t pos = p_body->p_cells[p_body->tail];
+    bitset_clear(p_body->p_occupied, (pos.y * p_body->width) + pos.x);
+
+    if (NULL != p_pos)
+    {
+        *p_pos = pos;
+    }
+
+    p_body->tail++;
+
+    if (p_body->capacity == p_body->tail)
+    {
+        p_body->tail = 0;
+    }
+
+    p_body->length--;
+    status = BODY_OK;
+
+EXIT:
+    return status;
+}
+
+
+point_t body_head (const body_t * p_body)
+{
+    return p_body->p_cells[p_body->head];
+}
+
+
+point_t body_tail (const body_t * p_body)
+{
+    return p_body->p_cells[p_body->tail];
+}
+
+
+size_t body_length (const body_t * p_body)
+{
+    return (NULL == p_body) ? 0 : p_body->length;
+}
+
+
+bool body_contains (const body_t * p_body, point_t pos)
+{
+    bool b_is_in = false;
+
+    if ((NULL == p_body) || (0 > pos.x) || (p_body->width <= (size_t)pos.x)
+        || (0 > pos.y) || (p_body->height <= (size_t)pos.y))
+    {
+        goto EXIT;
+    }
+
+    b_is_in = bitset_test(p_body->p_occupied,
+                          ((size_t)pos.y * p_body->width) + (size_t)pos.x);
+
+EXIT:
+    return b_is_in;
+}
+
+/*** end of file ***/
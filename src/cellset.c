@@ -0,0 +1,39 @@
+/**
+ * @file cellset.c
+ * @author Daniel Chung
+ * @brief Sparse set of board cells implementation
+ * @version 0.1
+ * @date 2024-04-09
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/cellset.h"
+
+void cellset_init (cellset_t *  p_set,
+                   uint32_t *   p_dense,
+                   uint32_t *   p_slots,
+                   const size_t capacity)
+{
+    if (NULL == p_set)
+    {
+        goto EXIT;
+    }
+
+    p_set->p_dense  = p_dense;
+    p_set->p_slots  = p_slots;
+    p_set->size     = capacity;
+    p_set->capacity = capacity;
+
+    for (size_t cell = 0; cell < capacity; cell++)
+    {
+        p_dense[cell] = (uint32_t)cell;
+        p_slots[cell] = (uint32_t)cell;
+    }
+
+EXIT:
+    return;
+}
+
+/*** end of file ***/
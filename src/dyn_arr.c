@@ -10,6 +10,9 @@
  * lock to allow multiple readers or a single writer to access the array. The
  * array resizes by doubling the capacity when the array is full.
  *
+ * Arrays created unsynchronized skip the lock entirely, for callers that only
+ * ever touch them from one thread.
+ *
  * @copyright Copyright (c) 2024
  *
  */
@@ -33,8 +36,64 @@
  */
 static int dyn_arr_resize (dyn_arr_t * p_dyn_arr, const size_t new_capacity);
 
+/**
+ * @brief Lock helpers that do nothing for an unsynchronized array
+ *
+ * @param p_dyn_arr Pointer to dynamic array
+ * @retval 0 on success, or always for an unsynchronized array
+ * @retval non-zero pthread error otherwise
+ */
+static inline int dyn_arr_rdlock (dyn_arr_t * p_dyn_arr)
+{
+    int status = 0;
+
+    if (p_dyn_arr->b_is_synced)
+    {
+        status = pthread_rwlock_rdlock(&(p_dyn_arr->da_rwlock));
+    }
+
+    return status;
+}
+
+static inline int dyn_arr_wrlock (dyn_arr_t * p_dyn_arr)
+{
+    int status = 0;
+
+    if (p_dyn_arr->b_is_synced)
+    {
+        status = pthread_rwlock_wrlock(&(p_dyn_arr->da_rwlock));
+    }
+
+    return status;
+}
+
+static inline int dyn_arr_unlock (dyn_arr_t * p_dyn_arr)
+{
+    int status = 0;
+
+    if (p_dyn_arr->b_is_synced)
+    {
+        status = pthread_rwlock_unlock(&(p_dyn_arr->da_rwlock));
+    }
+
+    return status;
+}
+
 
 dyn_arr_t * dyn_arr_create (const size_t capacity)
+{
+    dyn_arr_t * p_new_arr = dyn_arr_create_unsync(capacity);
+
+    if (NULL != p_new_arr)
+    {
+        p_new_arr->b_is_synced = true;
+    }
+
+    return p_new_arr;
+}
+
+
+dyn_arr_t * dyn_arr_create_unsync (const size_t capacity)
 {
     dyn_arr_t * p_new_arr = (dyn_arr_t *)calloc(1, sizeof(dyn_arr_t));
 
@@ -113,7 +172,7 @@ int dyn_arr_append (dyn_arr_t * p_dyn_arr, void * p_data)
         goto EXIT;
     }
 
-    if (0 != pthread_rwlock_wrlock(&(p_dyn_arr->da_rwlock)))
+    if (0 != dyn_arr_wrlock(p_dyn_arr))
     {
         perror("Failed to acquire write lock for dyn_arr\n");
         status = DYN_ARR_RWLOCK;
@@ -128,7 +187,7 @@ int dyn_arr_append (dyn_arr_t * p_dyn_arr, void * p_data)
         {
             (void)fprintf(stderr, "Failed to resize array!!\n");
 
-            if (0 != pthread_rwlock_unlock(&(p_dyn_arr->da_rwlock)))
+            if (0 != dyn_arr_unlock(p_dyn_arr))
             {
                 perror("Failed to release write lock for dyn_arr\n");
                 status = DYN_ARR_RWLOCK;
@@ -142,7 +201,7 @@ int dyn_arr_append (dyn_arr_t * p_dyn_arr, void * p_data)
     p_dyn_arr->size++;
     status = DYN_ARR_OK;
 
-    if (0 != pthread_rwlock_unlock(&(p_dyn_arr->da_rwlock)))
+    if (0 != dyn_arr_unlock(p_dyn_arr))
     {
         perror("Failed to release write lock for dyn_arr\n");
         status = DYN_ARR_RWLOCK;
@@ -163,7 +222,7 @@ void * dyn_arr_get (dyn_arr_t * p_dyn_arr, const size_t index)
         goto EXIT;
     }
 
-    if (0 != pthread_rwlock_rdlock(&(p_dyn_arr->da_rwlock)))
+    if (0 != dyn_arr_rdlock(p_dyn_arr))
     {
         perror("Failed to acquire read lock for dyn_arr\n");
         goto EXIT;
@@ -173,7 +232,7 @@ void * dyn_arr_get (dyn_arr_t * p_dyn_arr, const size_t index)
     {
         (void)fprintf(stderr, "Invalid index\n");
 
-        if (0 != pthread_rwlock_unlock(&(p_dyn_arr->da_rwlock)))
+        if (0 != dyn_arr_unlock(p_dyn_arr))
         {
             perror("Failed to release read lock for dyn_arr\n");
         }
@@ -183,7 +242,7 @@ void * dyn_arr_get (dyn_arr_t * p_dyn_arr, const size_t index)
 
     p_data = p_dyn_arr->pp_arr[index];
 
-    if (0 != pthread_rwlock_unlock(&(p_dyn_arr->da_rwlock)))
+    if (0 != dyn_arr_unlock(p_dyn_arr))
     {
         perror("Failed to release read lock for dyn_arr\n");
         p_data = NULL;
@@ -212,7 +271,7 @@ int dyn_arr_set (dyn_arr_t * p_dyn_arr, void * p_data, const size_t index)
         goto EXIT;
     }
 
-    if (0 != pthread_rwlock_wrlock(&(p_dyn_arr->da_rwlock)))
+    if (0 != dyn_arr_wrlock(p_dyn_arr))
     {
         perror("Failed to acquire write lock for dyn_arr\n");
         status = DYN_ARR_RWLOCK;
@@ -228,7 +287,7 @@ int dyn_arr_set (dyn_arr_t * p_dyn_arr, void * p_data, const size_t index)
             (void)fprintf(stderr, "Failed to resize array!!\n");
             status = DYN_ARR_ERROR;
 
-            if (0 != pthread_rwlock_unlock(&(p_dyn_arr->da_rwlock)))
+            if (0 != dyn_arr_unlock(p_dyn_arr))
             {
                 perror("Failed to release write lock for dyn_arr\n");
                 status = DYN_ARR_RWLOCK;
@@ -238,7 +297,7 @@ int dyn_arr_set (dyn_arr_t * p_dyn_arr, void * p_data, const size_t index)
         }
     }
 
-    if (0 != pthread_rwlock_unlock(&(p_dyn_arr->da_rwlock)))
+    if (0 != dyn_arr_unlock(p_dyn_arr))
     {
         perror("Failed to release write lock for dyn_arr\n");
         status = DYN_ARR_RWLOCK;
@@ -258,7 +317,7 @@ int dyn_arr_remove (dyn_arr_t * p_dyn_arr, const size_t index)
 {
     int status = DYN_ARR_GENERAL;
 
-    if (0 != pthread_rwlock_wrlock(&(p_dyn_arr->da_rwlock)))
+    if (0 != dyn_arr_wrlock(p_dyn_arr))
     {
         perror("Failed to acquire write lock for dyn_arr\n");
         status = DYN_ARR_RWLOCK;
@@ -275,7 +334,7 @@ int dyn_arr_remove (dyn_arr_t * p_dyn_arr, const size_t index)
     {
         status = DYN_ARR_INVALID;
 
-        if (0 != pthread_rwlock_unlock(&(p_dyn_arr->da_rwlock)))
+        if (0 != dyn_arr_unlock(p_dyn_arr))
         {
             perror("Failed to release write lock for dyn_arr\n");
             status = DYN_ARR_RWLOCK;
@@ -295,7 +354,7 @@ int dyn_arr_remove (dyn_arr_t * p_dyn_arr, const size_t index)
     p_dyn_arr->size--;
     status = DYN_ARR_OK;
 
-    if (0 != pthread_rwlock_unlock(&(p_dyn_arr->da_rwlock)))
+    if (0 != dyn_arr_unlock(p_dyn_arr))
     {
         perror("Failed to release write lock for dyn_arr\n");
         status = DYN_ARR_RWLOCK;
@@ -306,6 +365,100 @@ EXIT:
 }
 
 
+
+int dyn_arr_swap_remove (dyn_arr_t * p_dyn_arr, const size_t index)
+{
+    int status = DYN_ARR_GENERAL;
+
+    if (NULL == p_dyn_arr)
+    {
+        (void)fprintf(stderr, "Dynamic array is NULL\n");
+        status = DYN_ARR_NULL;
+        goto EXIT;
+    }
+
+    if (0 != dyn_arr_wrlock(p_dyn_arr))
+    {
+        perror("Failed to acquire write lock for dyn_arr\n");
+        status = DYN_ARR_RWLOCK;
+        goto EXIT;
+    }
+
+    if (p_dyn_arr->size <= index)
+    {
+        status = DYN_ARR_BOUNDS;
+    }
+    else
+    {
+        p_dyn_arr->size--;
+        p_dyn_arr->pp_arr[index] = p_dyn_arr->pp_arr[p_dyn_arr->size];
+        p_dyn_arr->pp_arr[p_dyn_arr->size] = NULL;
+        status                             = DYN_ARR_OK;
+    }
+
+    if (0 != dyn_arr_unlock(p_dyn_arr))
+    {
+        perror("Failed to release write lock for dyn_arr\n");
+        status = DYN_ARR_RWLOCK;
+    }
+
+EXIT:
+    return status;
+}
+
+
+int dyn_arr_remove_if (dyn_arr_t *    p_dyn_arr,
+                       dyn_arr_pred_f should_remove,
+                       void *         p_ctx)
+{
+    int status = DYN_ARR_GENERAL;
+
+    if ((NULL == p_dyn_arr) || (NULL == should_remove))
+    {
+        (void)fprintf(stderr, "Invalid arguments\n");
+        status = DYN_ARR_NULL;
+        goto EXIT;
+    }
+
+    if (0 != dyn_arr_wrlock(p_dyn_arr))
+    {
+        perror("Failed to acquire write lock for dyn_arr\n");
+        status = DYN_ARR_RWLOCK;
+        goto EXIT;
+    }
+
+    size_t kept = 0;
+
+    for (size_t idx = 0; idx < p_dyn_arr->size; idx++)
+    {
+        void * p_data = p_dyn_arr->pp_arr[idx];
+
+        if (!should_remove(p_data, p_ctx))
+        {
+            p_dyn_arr->pp_arr[kept] = p_data;
+            kept++;
+        }
+    }
+
+    // clear the vacated tail so slots past size stay NULL
+    for (size_t idx = kept; idx < p_dyn_arr->size; idx++)
+    {
+        p_dyn_arr->pp_arr[idx] = NULL;
+    }
+
+    p_dyn_arr->size = kept;
+    status          = DYN_ARR_OK;
+
+    if (0 != dyn_arr_unlock(p_dyn_arr))
+    {
+        perror("Failed to release write lock for dyn_arr\n");
+        status = DYN_ARR_RWLOCK;
+    }
+
+EXIT:
+    return status;
+}
+
 static int dyn_arr_resize (dyn_arr_t * p_dyn_arr, const size_t new_capacity)
 {
     int status = DYN_ARR_GENERAL;
@@ -324,28 +477,24 @@ static int dyn_arr_resize (dyn_arr_t * p_dyn_arr, const size_t new_capacity)
         goto EXIT;
     }
 
-    void ** pp_new_arr = (void **)calloc(new_capacity, sizeof(void *));
+    // realloc can usually grow in place, so only the new slots need touching
+    void ** pp_new_arr
+        = (void **)realloc(p_dyn_arr->pp_arr, new_capacity * sizeof(void *));
 
     if (NULL == pp_new_arr)
     {
-        perror("calloc");
+        perror("realloc");
         status = DYN_ARR_ALLOC;
         goto EXIT;
     }
 
-    // set all to NULL
-    for (int cap_idx = 0; cap_idx < new_capacity; cap_idx++)
+    // set the new slots to NULL
+    for (size_t cap_idx = p_dyn_arr->capacity; cap_idx < new_capacity;
+         cap_idx++)
     {
         pp_new_arr[cap_idx] = NULL;
     }
 
-    // copy over values from old array to new array
-    for (int cap_idx = 0; cap_idx < p_dyn_arr->capacity; cap_idx++)
-    {
-        pp_new_arr[cap_idx] = p_dyn_arr->pp_arr[cap_idx];
-    }
-
-    free(p_dyn_arr->pp_arr);
     p_dyn_arr->pp_arr   = pp_new_arr;
     p_dyn_arr->capacity = new_capacity;
     status              = DYN_ARR_OK;
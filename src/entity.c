@@ -1,21 +1,20 @@
 #include "../include/entity.h"
 
-entity_t * entity_create (point_t pos, point_t dir, entity_type_t type)
+void entity_init (entity_t *    p_entity,
+                  point_t       pos,
+                  point_t       dir,
+                  entity_type_t type)
 {
-    entity_t * p_new_entity = NULL;
-
-    p_new_entity = (entity_t *)calloc(1, sizeof(entity_t));
-
-    if (NULL == p_new_entity)
+    if (NULL == p_entity)
     {
-        perror("malloc");
         goto EXIT;
     }
 
-    p_new_entity->pos          = pos;
-    p_new_entity->dir          = dir;
-    p_new_entity->entity_type  = type;
-    p_new_entity->is_deletable = false;
+    p_entity->pos          = pos;
+    p_entity->dir          = dir;
+    p_entity->score        = 0;
+    p_entity->entity_type  = type;
+    p_entity->is_deletable = false;
 
     switch (type)
     {
@@ -24,13 +23,19 @@ entity_t * entity_create (point_t pos, point_t dir, entity_type_t type)
         case PLAYER:
             break;
         case FOOD:
+            p_entity->score = ENTITY_FOOD_SCORE;
             break;
         default:
             goto EXIT;
     }
 
 EXIT:
-    return (p_new_entity);
+    return;
+}
+
+bool entity_is_deletable (const entity_t * p_entity)
+{
+    return (NULL != p_entity) && p_entity->is_deletable;
 }
 
 /*** end of file ***/
@@ -0,0 +1,228 @@
+/**
+ * @file frame.c
+ * @author Daniel Chung
+ * @brief Batched terminal frame buffer implementation
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/frame.h"
+
+/**
+ * @brief Makes room for len more bytes, flushing early if the buffer is full
+ *
+ * @param p_frame Pointer to frame
+ * @param len Count of bytes about to be buffered
+ * @retval FRAME_OK on success (0)
+ * @retval FRAME_WRITE if the early flush failed
+ */
+static int frame_reserve (frame_t * p_frame, size_t len);
+
+
+frame_t * frame_create (int fd, size_t capacity)
+{
+    frame_t * p_new_frame = NULL;
+
+    if (FRAME_GOTO_MAX > capacity)
+    {
+        (void)fprintf(stderr, "Invalid capacity\n");
+        goto EXIT;
+    }
+
+    p_new_frame = (frame_t *)calloc(1, sizeof(frame_t));
+
+    if (NULL == p_new_frame)
+    {
+        perror("malloc");
+        goto EXIT;
+    }
+
+    p_new_frame->p_buf = (char *)malloc(capacity);
+
+    if (NULL == p_new_frame->p_buf)
+    {
+        perror("malloc");
+        free(p_new_frame);
+        p_new_frame = NULL;
+        goto EXIT;
+    }
+
+    p_new_frame->capacity = capacity;
+    p_new_frame->len      = 0;
+    p_new_frame->fd       = fd;
+    frame_forget_cursor(p_new_frame);
+
+EXIT:
+    return p_new_frame;
+}
+
+
+void frame_destroy (frame_t ** pp_frame)
+{
+    if ((NULL == pp_frame) || (NULL == *pp_frame))
+    {
+        goto EXIT;
+    }
+
+    free((*pp_frame)->p_buf);
+    free(*pp_frame);
+    *pp_frame = NULL;
+
+EXIT:
+    return;
+}
+
+
+int frame_goto (frame_t * p_frame, int x, int y)
+{
+    int status = FRAME_GENERAL;
+
+    if (NULL == p_frame)
+    {
+        status = FRAME_NULL;
+        goto EXIT;
+    }
+
+    if ((x == p_frame->cursor_x) && (y == p_frame->cursor_y))
+    {
+        status = FRAME_OK;
+        goto EXIT;
+    }
+
+    status = frame_reserve(p_frame, FRAME_GOTO_MAX);
+
+    if (FRAME_OK != status)
+    {
+        goto EXIT;
+    }
+
+    p_frame->len += (size_t)snprintf(p_frame->p_buf + p_frame->len,
+                                     FRAME_GOTO_MAX,
+                                     "\033[%d;%dH",
+                                     y,
+                                     x);
+    p_frame->cursor_x = x;
+    p_frame->cursor_y = y;
+
+EXIT:
+    return status;
+}
+
+
+int frame_puts (frame_t * p_frame, const char * p_str)
+{
+    int    status = FRAME_GENERAL;
+    size_t len    = 0;
+
+    if ((NULL == p_frame) || (NULL == p_str))
+    {
+        status = FRAME_NULL;
+        goto EXIT;
+    }
+
+    len = strlen(p_str);
+
+    while (len > p_frame->capacity - p_frame->len)
+    {
+        // larger than what is left, fill the buffer and send it
+        size_t chunk = p_frame->capacity - p_frame->len;
+
+        memcpy(p_frame->p_buf + p_frame->len, p_str, chunk);
+        p_frame->len += chunk;
+        p_str += chunk;
+        len -= chunk;
+        p_frame->cursor_x += (int)chunk;
+
+        status = frame_flush(p_frame);
+
+        if (FRAME_OK != status)
+        {
+            goto EXIT;
+        }
+    }
+
+    memcpy(p_frame->p_buf + p_frame->len, p_str, len);
+    p_frame->len += len;
+    p_frame->cursor_x += (int)len;
+    status = FRAME_OK;
+
+EXIT:
+    return status;
+}
+
+
+void frame_forget_cursor (frame_t * p_frame)
+{
+    if (NULL != p_frame)
+    {
+        p_frame->cursor_x = 0;
+        p_frame->cursor_y = 0;
+    }
+}
+
+
+int frame_flush (frame_t * p_frame)
+{
+    int    status  = FRAME_GENERAL;
+    size_t written = 0;
+
+    if (NULL == p_frame)
+    {
+        status = FRAME_NULL;
+        goto EXIT;
+    }
+
+    while (written < p_frame->len)
+    {
+        ssize_t count = write(
+            p_frame->fd, p_frame->p_buf + written, p_frame->len - written);
+
+        if (0 > count)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+            {
+                // the tty shares O_NONBLOCK with stdin, wait until it drains
+                struct pollfd pfd = { .fd = p_frame->fd, .events = POLLOUT };
+                (void)poll(&pfd, 1, -1);
+                continue;
+            }
+
+            perror("write");
+            p_frame->len = 0;
+            frame_forget_cursor(p_frame);
+            status = FRAME_WRITE;
+            goto EXIT;
+        }
+
+        written += (size_t)count;
+    }
+
+    p_frame->len = 0;
+    status       = FRAME_OK;
+
+EXIT:
+    return status;
+}
+
+
+static int frame_reserve (frame_t * p_frame, size_t len)
+{
+    int status = FRAME_OK;
+
+    if (len > p_frame->capacity - p_frame->len)
+    {
+        status = frame_flush(p_frame);
+    }
+
+    return status;
+}
+
+/*** end of file ***/
@@ -1,38 +1,51 @@
 #include "../include/game.h"
+#include "../include/profile.h"
 
-static struct timeval g_time_last = { 0 };
-entity_t *            gp_snake    = NULL;
-point_t               g_zero      = { 0 };
+static inline bool game_is_on_board (const game_t * p_game, point_t pos)
+{
+    return (0 <= pos.x) && ((size_t)pos.x < p_game->width) && (0 <= pos.y)
+           && ((size_t)pos.y < p_game->height);
+}
+
+static inline size_t game_cell (const game_t * p_game, point_t pos)
+{
+    return ((size_t)pos.y * p_game->width) + (size_t)pos.x;
+}
 
 static void game_place_tile (game_t * p_game, point_t pos, entity_type_t type)
 {
-    if ((NULL == p_game) || (0 > pos.x) || (p_game->game_size <= pos.x)
-        || (0 > pos.y) || (p_game->game_size <= pos.y))
+    PROFILE_BEGIN(PROFILE_PLACE);
+
+    if ((NULL == p_game) || !game_is_on_board(p_game, pos))
     {
         goto EXIT;
     }
 
-    p_game->p_tile_matrix[(pos.y * p_game->game_size) + pos.x].tile_type = type;
-    term_gotoxy(pos.x * OFFSET + 1, pos.y + 1);
+    size_t        cell = game_cell(p_game, pos);
+    entity_type_t old  = tiles_get(&p_game->tiles, cell);
 
-    switch (type)
+    // an EMPTY tile has no key, and placing the same type XORs out to nothing
+    p_game->hash ^= (EMPTY == old) ? 0 : zobrist_key(cell, old);
+    p_game->hash ^= (EMPTY == type) ? 0 : zobrist_key(cell, type);
+    tiles_set(&p_game->tiles, cell, type);
+
+    // every tile change goes through here, so the empty set never drifts
+    if (EMPTY == type)
     {
-        case EMPTY:
-            (void)fprintf(stdout, GAME_ICON_EMPTY);
-            break;
-        case PLAYER:
-            (void)fprintf(stdout, GAME_ICON_PLAYER);
-            break;
-        case FOOD:
-            (void)fprintf(stdout, GAME_ICON_FOOD);
-            break;
-        default:
-            break;
+        cellset_insert(&p_game->empty_cells, cell);
+    }
+    else
+    {
+        cellset_remove(&p_game->empty_cells, cell);
     }
 
-    fflush(stdout);
+    if (NULL != p_game->renderer.draw_tile)
+    {
+        p_game->renderer.draw_tile(p_game->renderer.p_ctx, pos, type);
+    }
 
 EXIT:
+    PROFILE_END(PROFILE_PLACE);
     return;
 }
 
@@ -43,34 +56,26 @@ static int game_add_entity (game_t *      p_game,
 {
     int status = -1;
 
-    if ((NULL == p_game) || (0 > pos.x) || (p_game->game_size <= pos.x)
-        || (0 > pos.y) || (p_game->game_size <= pos.y))
+    if ((NULL == p_game) || !game_is_on_board(p_game, pos))
     {
         goto EXIT;
     }
 
-    entity_t * p_new_entity = entity_create(pos, dir, type);
+    entity_t new_entity = { 0 };
+    size_t   entity_idx = p_game->food.size;
 
-    if (NULL == p_new_entity)
-    {
-        goto EXIT;
-    }
-
-    p_new_entity->score = 0;
+    entity_init(&new_entity, pos, dir, type);
 
     switch (type)
     {
-        case PLAYER:;
-            entity_t * p_next   = (entity_t *)sll_get(p_game->p_snake, 0);
-            p_new_entity->dir.x = p_next->dir.x;
-            p_new_entity->dir.y = p_next->dir.y;
-            status = sll_prepend(p_game->p_snake, p_new_entity, false);
-            break;
         case FOOD:
-            p_new_entity->score = 1;
-            p_new_entity->pos.x = pos.x;
-            p_new_entity->pos.y = pos.y;
-            status = dyn_arr_append(p_game->p_entity_arr, p_new_entity);
+            status = entity_vec_push(&p_game->food, new_entity);
+
+            if (VEC_OK == status)
+            {
+                p_game->p_food_index[game_cell(p_game, pos)]
+                    = (uint32_t)entity_idx;
+            }
             break;
         default:
             break;
@@ -78,10 +83,8 @@ static int game_add_entity (game_t *      p_game,
 
     if (0 != status)
     {
-        perror("dyn_arr_append");
-        free(p_new_entity);
-        p_new_entity = NULL;
-        status       = -1;
+        (void)fprintf(stderr, "Failed to add entity\n");
+        status = -1;
         goto EXIT;
     }
 
@@ -89,174 +92,225 @@ EXIT:
     return (status);
 }
 
-static int snake_cmp_f (void * p_pos1, void * p_pos2)
+/**
+ * @brief Finds an empty tile to spawn on
+ *
+ * @note Constant time, picks uniformly from the set of empty cells.
+ *
+ * @param p_game Pointer to game
+ * @param p_pos Receives the empty position
+ * @retval true if an empty tile was found
+ * @retval false if the board is full
+ */
+static bool game_find_empty (game_t * p_game, point_t * p_pos)
 {
-    int status = -1;
+    bool   b_is_found = false;
+    size_t free_count = p_game->empty_cells.size;
 
-    if ((NULL == p_pos1) || (NULL == p_pos2))
+    if (0 < free_count)
     {
-        goto EXIT;
-    }
-
-    point_t * p_point1 = (point_t *)p_pos1;
-    point_t * p_point2 = (point_t *)p_pos2;
+        size_t cell = cellset_at(&p_game->empty_cells,
+                                 rng_below(&p_game->rng, free_count));
 
-    if ((p_point1->x == p_point2->x) && (p_point1->y == p_point2->y))
-    {
-        printf("Snake collision\n");
-        exit(1);
-        status = 0;
+        p_pos->x   = (int)(cell % p_game->width);
+        p_pos->y   = (int)(cell / p_game->width);
+        b_is_found = true;
     }
 
-EXIT:
-    return (status);
+    return (b_is_found);
 }
 
-game_t * game_init (size_t game_size)
+/**
+ * @brief Sweeps food flagged as deletable out of the food array
+ *
+ * @note One pass over the food, then the cells of the food that slid down
+ * are pointed at their new indices.
+ *
+ * @param p_game Pointer to game
+ */
+static void game_sweep_food (game_t * p_game)
 {
-    game_t * p_new_game = NULL;
-
-    if (0 == game_size)
+    if (0 == entity_vec_remove_if(&p_game->food, entity_is_deletable))
     {
         goto EXIT;
     }
 
-    p_new_game = (game_t *)calloc(1, sizeof(game_t));
-
-    if (NULL == p_new_game)
+    for (size_t idx = 0; idx < p_game->food.size; idx++)
     {
-        perror("malloc");
-        goto EXIT;
+        point_t pos = p_game->food.p_items[idx].pos;
+
+        p_game->p_food_index[game_cell(p_game, pos)] = (uint32_t)idx;
     }
 
-    p_new_game->score        = 0;
-    p_new_game->game_size    = game_size;
-    p_new_game->p_entity_arr = dyn_arr_create(DEFAULT_ARR_CAP);
+EXIT:
+    return;
+}
+
+/**
+ * @brief Gets the bytes a game of a given size needs from its arena
+ *
+ * @note Must list exactly what game_init allocates from the arena.
+ *
+ * @param cells Count of cells on the board
+ * @param food_cap Count of food entities the game can hold
+ * @return size_t Size of the arena
+ */
+static size_t game_footprint (size_t cells, size_t food_cap)
+{
+    return ARENA_ALIGN(sizeof(game_t))
+           + ARENA_ALIGN(food_cap * sizeof(entity_t))
+           + ARENA_ALIGN(sizeof(body_t))
+           + ARENA_ALIGN(cells * sizeof(point_t))
+           + ARENA_ALIGN(sizeof(bitset_t))
+           + ARENA_ALIGN(BITSET_WORDS(cells) * sizeof(uint64_t))
+           + ARENA_ALIGN(TILES_WORDS(cells) * sizeof(uint64_t))
+           + (2 * ARENA_ALIGN(cells * sizeof(uint32_t)))
+           + ARENA_ALIGN(cells * sizeof(uint32_t));
+}
 
-    if (NULL == p_new_game->p_entity_arr)
+game_t * game_init (size_t width, size_t height, uint64_t seed)
+{
+    game_t *  p_new_game = NULL;
+    arena_t * p_arena    = NULL;
+    size_t    cells      = width * height;
+    // every entity the board can hold, so the tick path never allocates
+    size_t food_cap = (GAME_FOOD_COUNT < cells) ? GAME_FOOD_COUNT : cells;
+
+    if ((GAME_MIN_WIDTH > width) || (GAME_MIN_HEIGHT > height)
+        || (GAME_MAX_SIZE < width) || (GAME_MAX_SIZE < height))
     {
-        perror("dyn_arr_create");
-        free(p_new_game);
-        p_new_game = NULL;
+        (void)fprintf(stderr,
+                      "Board must be %d to %d wide and %d to %d high\n",
+                      GAME_MIN_WIDTH,
+                      GAME_MAX_SIZE,
+                      GAME_MIN_HEIGHT,
+                      GAME_MAX_SIZE);
         goto EXIT;
     }
 
-    p_new_game->p_snake = sll_create(snake_cmp_f);
+    // the whole game is one arena allocation, released at once by game_destroy
+    p_arena = arena_create(game_footprint(cells, food_cap));
 
-    if (NULL == p_new_game->p_snake)
+    if (NULL == p_arena)
     {
-        perror("dyn_arr_create");
-        dyn_arr_destroy(&(p_new_game->p_entity_arr));
-        free(p_new_game);
-        p_new_game = NULL;
         goto EXIT;
     }
 
-    p_new_game->p_tile_matrix = (game_tile_t *)calloc(
-        p_new_game->game_size * p_new_game->game_size, sizeof(entity_t));
-
-    if (NULL == p_new_game->p_tile_matrix)
+    p_new_game = (game_t *)arena_alloc(p_arena, sizeof(game_t));
+
+    body_t *   p_body = (body_t *)arena_alloc(p_arena, sizeof(body_t));
+    bitset_t * p_occupied
+        = (bitset_t *)arena_alloc(p_arena, sizeof(bitset_t));
+    // from here on nothing holds a pointer, so this run of the arena is the
+    // state block a snapshot copies in one go
+    entity_t * p_entities
+        = (entity_t *)arena_alloc(p_arena, food_cap * sizeof(entity_t));
+    point_t * p_cells
+        = (point_t *)arena_alloc(p_arena, cells * sizeof(point_t));
+    uint64_t * p_words = (uint64_t *)arena_alloc(
+        p_arena, BITSET_WORDS(cells) * sizeof(uint64_t));
+    uint64_t * p_tile_words = (uint64_t *)arena_alloc(
+        p_arena, TILES_WORDS(cells) * sizeof(uint64_t));
+    uint32_t * p_empty_dense
+        = (uint32_t *)arena_alloc(p_arena, cells * sizeof(uint32_t));
+    uint32_t * p_empty_slots
+        = (uint32_t *)arena_alloc(p_arena, cells * sizeof(uint32_t));
+    uint32_t * p_food_index
+        = (uint32_t *)arena_alloc(p_arena, cells * sizeof(uint32_t));
+
+    if (NULL == p_food_index)
     {
-        perror("malloc");
-        sll_destroy(&(p_new_game->p_snake));
-        dyn_arr_destroy(&(p_new_game->p_entity_arr));
-        free(p_new_game);
+        (void)fprintf(stderr, "Failed to lay out game arena\n");
+        arena_destroy(&p_arena);
         p_new_game = NULL;
         goto EXIT;
     }
 
-    for (uint8_t y_idx = 0; y_idx < game_size; y_idx++)
+    bitset_init(p_occupied, p_words, cells);
+    body_init(p_body, p_cells, p_occupied, width, height);
+    tiles_init(&p_new_game->tiles, p_tile_words, cells);
+    // every tile starts EMPTY, so every cell starts in the set
+    cellset_init(&p_new_game->empty_cells, p_empty_dense, p_empty_slots, cells);
+    // food is held by value in the arena, so spawning never allocates
+    entity_vec_init_fixed(&p_new_game->food, p_entities, food_cap);
+
+    p_new_game->p_arena       = p_arena;
+    p_new_game->p_body        = p_body;
+    p_new_game->p_food_index  = p_food_index;
+    p_new_game->p_state       = (uint8_t *)p_entities;
+    p_new_game->state_size
+        = (size_t)((uint8_t *)&p_food_index[cells] - (uint8_t *)p_entities);
+    p_new_game->score         = 0;
+    p_new_game->width         = width;
+    p_new_game->height        = height;
+    p_new_game->seed          = seed;
+    rng_seed(&p_new_game->rng, seed);
+
+    // GAME_NO_ENTITY is all ones, and the arena is already zero, which is
+    // EMPTY for every tile
+    memset(p_food_index, 0xFF, cells * sizeof(uint32_t));
+
+    point_t pos = { .x = 0, .y = (int)(height / 2) };
+
+    p_new_game->dir.x = 1;
+    p_new_game->dir.y = 0;
+    p_new_game->hash  = zobrist_dir(p_new_game->dir);
+
+    // push from the tail so the head ends up at x = 2
+    for (; pos.x < 3; pos.x++)
     {
-        for (uint8_t x_idx = 0; x_idx < game_size; x_idx++)
-        {
-            point_t pos = { .x = x_idx, .y = y_idx };
-            game_place_tile(p_new_game, pos, EMPTY);
-        }
+        body_push_head(p_new_game->p_body, pos);
+        game_place_tile(p_new_game, pos, PLAYER);
     }
 
-    point_t pos = { .x = 2, .y = game_size / 2 };
-    point_t dir = { .x = 1, .y = 0 };
-
-    entity_t * p_snake_head = entity_create(pos, dir, PLAYER);
-    sll_prepend(p_new_game->p_snake, p_snake_head, false);
-    game_place_tile(p_new_game, pos, PLAYER);
-
-    pos.x -= 1;
-    game_add_entity(p_new_game, pos, g_zero, PLAYER);
-    game_place_tile(p_new_game, pos, PLAYER);
+    p_new_game->hash ^= zobrist_key(
+        game_cell(p_new_game, body_head(p_new_game->p_body)), ZOBRIST_HEAD);
 
-    pos.x -= 1;
-    game_add_entity(p_new_game, pos, g_zero, PLAYER);
-    game_place_tile(p_new_game, pos, PLAYER);
-
-    (void)gettimeofday(&g_time_last, NULL);
-    srand(time(NULL));
-
-    for (int start_food = 0; start_food < 5; start_food++)
+    for (int start_food = 0; start_food < GAME_FOOD_COUNT; start_food++)
     {
-        pos.x = rand() % p_new_game->game_size;
-        pos.y = rand() % p_new_game->game_size;
-        game_add_entity(p_new_game, pos, g_zero, FOOD);
+        if (!game_find_empty(p_new_game, &pos))
+        {
+            break;
+        }
+
+        game_add_entity(p_new_game, pos, (point_t) { 0 }, FOOD);
         game_place_tile(p_new_game, pos, FOOD);
     }
 EXIT:
     return (p_new_game);
 }
 
-void game_print_tiles (game_t * p_game)
+void game_set_renderer (game_t * p_game, const game_renderer_t * p_renderer)
 {
-    system("clear");
-
-    for (uint8_t i = 0; i < p_game->game_size; i++)
+    if (NULL == p_game)
     {
-        if (0 == i)
-        {
-            (void)fprintf(stdout, UPPER_LEFT);
-        }
-        (void)fprintf(stdout, HORIZONTAL);
+        goto EXIT;
     }
-    (void)fprintf(stdout, "%s\n", UPPER_RIGHT);
 
-    for (uint8_t i = 0; i < p_game->game_size; i++)
+    if (NULL == p_renderer)
     {
-        (void)fprintf(stdout, VERTICAL);
+        p_game->renderer = (game_renderer_t) { 0 };
+        goto EXIT;
+    }
 
-        for (uint8_t j = 0; j < p_game->game_size; j++)
-        {
-            entity_type_t tile_type
-                = p_game->p_tile_matrix[(i * p_game->game_size) + j].tile_type;
+    p_game->renderer = *p_renderer;
 
-            switch (tile_type)
-            {
-                case EMPTY:
-                    (void)fprintf(stdout, GAME_ICON_EMPTY);
-                    break;
-                case PLAYER:
-                    (void)fprintf(stdout, GAME_ICON_PLAYER);
-                    break;
-                case FOOD:
-                    (void)fprintf(stdout, GAME_ICON_FOOD);
-                    break;
-                default:
-                    (void)fprintf(stdout, GAME_ICON_EMPTY);
-                    break;
-            }
+    for (size_t y_idx = 0; y_idx < p_game->height; y_idx++)
+    {
+        for (size_t x_idx = 0; x_idx < p_game->width; x_idx++)
+        {
+            point_t pos = { .x = (int)x_idx, .y = (int)y_idx };
+            game_place_tile(p_game, pos, game_get_tile(p_game, pos));
         }
-
-        (void)fprintf(stdout, "%s\n", VERTICAL);
     }
 
-    for (uint8_t i = 0; i < p_game->game_size; i++)
+    if (NULL != p_game->renderer.draw_score)
     {
-        if (0 == i)
-        {
-            (void)fprintf(stdout, LOWER_LEFT);
-        }
-        (void)fprintf(stdout, HORIZONTAL);
+        p_game->renderer.draw_score(p_game->renderer.p_ctx, p_game->score);
     }
-    (void)fprintf(stdout, "%s\n", LOWER_RIGHT);
 
-    (void)fprintf(stdout, "Score: %d\n", p_game->score);
+EXIT:
+    return;
 }
 
 void game_destroy (game_t ** pp_game)
@@ -266,31 +320,10 @@ void game_destroy (game_t ** pp_game)
         goto EXIT;
     }
 
-    // if (NULL != (*pp_game)->p_entity_arr)
-    // {
-    //     entity_t * p_temp_entity = NULL;
-
-    //     size_t idx = 0;
-    //     for (; idx < (*pp_game)->p_entity_arr->size; idx++)
-    //     {
-    //         p_temp_entity
-    //             = (entity_t *)dyn_arr_get((*pp_game)->p_entity_arr, idx);
-    //         free(p_temp_entity);
-    //         p_temp_entity = NULL;
-    //         dyn_arr_remove((*pp_game)->p_entity_arr, idx);
-    //         idx--;
-    //     }
-    // }
-
-    dyn_arr_destroy(&((*pp_game)->p_entity_arr));
-    sll_destroy(&((*pp_game)->p_snake));
-
-    if (NULL != (*pp_game)->p_tile_matrix)
-    {
-        free((*pp_game)->p_tile_matrix);
-    }
+    // the game itself lives in the arena, so take the arena out first
+    arena_t * p_arena = (*pp_game)->p_arena;
 
-    free(*pp_game);
+    arena_destroy(&p_arena);
     *pp_game = NULL;
 
 EXIT:
@@ -299,126 +332,333 @@ EXIT:
 
 void game_turn_player (game_t * p_game, point_t dir)
 {
-    point_t curr_dir = ((entity_t *)p_game->p_snake->p_tail->p_data)->dir;
+    point_t curr_dir = p_game->dir;
 
     if (curr_dir.x + dir.x == 0 || curr_dir.y + dir.y == 0)
     {
         goto EXIT;
     }
 
-    ((entity_t *)p_game->p_snake->p_tail->p_data)->dir.x = dir.x;
-    ((entity_t *)p_game->p_snake->p_tail->p_data)->dir.y = dir.y;
+    p_game->hash ^= zobrist_dir(curr_dir) ^ zobrist_dir(dir);
+    p_game->dir.x = dir.x;
+    p_game->dir.y = dir.y;
 
 EXIT:
     return;
 }
 
-void game_print_score (game_t * p_game)
+bool game_is_colliding (const game_t * p_game, point_t pos)
 {
-    term_gotoxy(0, p_game->game_size + 2);
-    (void)fprintf(stdout, "Score: %d\n", p_game->score);
-    fflush(stdout);
+    bool b_is_colliding = true;
+
+    if ((NULL == p_game) || !game_is_on_board(p_game, pos))
+    {
+        goto EXIT;
+    }
+
+    // food never sits on the snake, so moving onto the tail never grows it
+    // and the tail moves out of the way the same tick
+    point_t tail   = body_tail(p_game->p_body);
+    b_is_colliding = ((tail.x != pos.x) || (tail.y != pos.y))
+                     && body_contains(p_game->p_body, pos);
+
+EXIT:
+    return (b_is_colliding);
 }
 
 bool game_tick (game_t * p_game)
 {
-    bool           should_update = false;
-    struct timeval time_now;
-    (void)gettimeofday(&time_now, NULL);
+    PROFILE_BEGIN(PROFILE_TICK);
+    bool should_update = false;
+
+    if ((NULL == p_game) || p_game->is_over)
+    {
+        goto EXIT;
+    }
 
-    uint64_t delta_time = (time_now.tv_sec - g_time_last.tv_sec) * 1000000
-                          + time_now.tv_usec - g_time_last.tv_usec;
+    point_t head    = body_head(p_game->p_body);
+    point_t new_pos = { .x = head.x + p_game->dir.x,
+                        .y = head.y + p_game->dir.y };
 
-    if (100000 > delta_time)
+    if (!game_is_on_board(p_game, new_pos))
     {
+        p_game->is_over = true;
         goto EXIT;
     }
 
-    g_time_last = time_now;
+    entity_t * p_food   = NULL;
+    size_t     cell     = game_cell(p_game, new_pos);
+    uint32_t   food_idx = p_game->p_food_index[cell];
 
-    // check if move will cause collision with itself
-    entity_t * p_snake_head = (entity_t *)p_game->p_snake->p_tail->p_data;
+    if (GAME_NO_ENTITY != food_idx)
+    {
+        p_food = entity_vec_at(&p_game->food, food_idx);
+    }
+
+    PROFILE_BEGIN(PROFILE_COLLIDE);
+    bool b_is_colliding = game_is_colliding(p_game, new_pos);
+    PROFILE_END(PROFILE_COLLIDE);
 
-    point_t new_pos = { .x = p_snake_head->pos.x + p_snake_head->dir.x,
-                        .y = p_snake_head->pos.y + p_snake_head->dir.y };
-    // check if snake head is colliding within itself
-    if (sll_is_in(p_game->p_snake, (const void *)&(new_pos)))
+    // decided before anything moves, so a lost game keeps its whole body
+    if (b_is_colliding)
     {
+        p_game->is_over = true;
         goto EXIT;
     }
 
-    entity_t * p_snake_tail = (entity_t *)p_game->p_snake->p_head->p_data;
-    // p_head is the tail of the snake
-    game_place_tile(p_game, p_snake_tail->pos, EMPTY);
+    PROFILE_BEGIN(PROFILE_MOVE);
+    point_t tail = body_tail(p_game->p_body);
+
+    // growing is just not releasing the tail
+    if (NULL == p_food)
+    {
+        body_pop_tail(p_game->p_body, NULL);
+        game_place_tile(p_game, tail, EMPTY);
+    }
 
-    sll_node_t * p_temp_node = p_game->p_snake->p_head;
+    body_push_head(p_game->p_body, new_pos);
+    p_game->hash ^= zobrist_key(game_cell(p_game, head), ZOBRIST_HEAD)
+                    ^ zobrist_key(cell, ZOBRIST_HEAD);
+    PROFILE_END(PROFILE_MOVE);
 
-    while (NULL != p_temp_node)
+    if (NULL != p_food)
     {
-        // the section before the head
-        if (NULL != p_temp_node->p_next)
+        p_game->score += p_food->score;
+        p_game->p_food_index[cell] = GAME_NO_ENTITY;
+
+        // respawn by moving the eaten entity, so nothing is removed from or
+        // added to the entity array
+        point_t pos = { 0 };
+
+        PROFILE_BEGIN(PROFILE_SPAWN);
+        bool b_is_found = game_find_empty(p_game, &pos);
+        PROFILE_END(PROFILE_SPAWN);
+
+        if (b_is_found)
         {
-            ((entity_t *)p_temp_node->p_data)->dir.x
-                = ((entity_t *)p_temp_node->p_next->p_data)->dir.x;
-            ((entity_t *)p_temp_node->p_data)->dir.y
-                = ((entity_t *)p_temp_node->p_next->p_data)->dir.y;
-            ((entity_t *)p_temp_node->p_data)->pos.x
-                = ((entity_t *)p_temp_node->p_next->p_data)->pos.x;
-            ((entity_t *)p_temp_node->p_data)->pos.y
-                = ((entity_t *)p_temp_node->p_next->p_data)->pos.y;
+            p_food->pos = pos;
+            p_game->p_food_index[game_cell(p_game, pos)] = food_idx;
+            game_place_tile(p_game, pos, FOOD);
+        }
+        else
+        {
+            // the board is full, so this food is gone for good
+            p_food->is_deletable = true;
+            game_sweep_food(p_game);
         }
 
-        p_temp_node = p_temp_node->p_next;
+        if (NULL != p_game->renderer.draw_score)
+        {
+            p_game->renderer.draw_score(p_game->renderer.p_ctx, p_game->score);
+        }
     }
 
-    p_snake_head->pos.x += p_snake_head->dir.x;
-    p_snake_head->pos.y += p_snake_head->dir.y;
+    game_place_tile(p_game, new_pos, PLAYER);
+    should_update = true;
+EXIT:
+    PROFILE_END(PROFILE_TICK);
+    return (should_update);
+}
 
-    if (0 > p_snake_head->pos.x || p_game->game_size <= p_snake_head->pos.x
-        || 0 > p_snake_head->pos.y || p_game->game_size <= p_snake_head->pos.y)
+bool game_step (game_t * p_game, point_t dir)
+{
+    if ((NULL != p_game) && ((0 != dir.x) || (0 != dir.y)))
     {
-        // gb_run = false;
+        game_turn_player(p_game, dir);
+    }
+
+    return (game_tick(p_game));
+}
+
+uint64_t game_get_hash (const game_t * p_game)
+{
+    return (NULL == p_game) ? 0 : p_game->hash;
+}
+
+size_t game_snapshot_size (const game_t * p_game)
+{
+    return (NULL == p_game)
+               ? 0
+               : ARENA_ALIGN(sizeof(game_state_t)) + p_game->state_size;
+}
+
+int game_snapshot (const game_t * p_game, void * p_buf, size_t size)
+{
+    int status = GAME_GENERAL;
+
+    if ((NULL == p_game) || (NULL == p_buf))
+    {
+        status = GAME_NULL;
         goto EXIT;
     }
 
-    size_t entity_idx = 0;
-    for (; entity_idx < p_game->p_entity_arr->size; entity_idx++)
+    if (game_snapshot_size(p_game) > size)
     {
-        entity_t * p_entity
-            = (entity_t *)dyn_arr_get(p_game->p_entity_arr, entity_idx);
+        status = GAME_SIZE;
+        goto EXIT;
+    }
 
-        if (p_snake_head->pos.x == p_entity->pos.x
-            && p_snake_head->pos.y == p_entity->pos.y)
-        {
-            p_entity->is_deletable = true;
-            p_game->score += p_entity->score;
+    game_state_t state = { .width       = p_game->width,
+                           .height      = p_game->height,
+                           .state_size  = p_game->state_size,
+                           .seed        = p_game->seed,
+                           .rng         = p_game->rng,
+                           .hash        = p_game->hash,
+                           .dir         = p_game->dir,
+                           .score       = p_game->score,
+                           .is_over     = p_game->is_over,
+                           .body_head   = p_game->p_body->head,
+                           .body_tail   = p_game->p_body->tail,
+                           .body_length = p_game->p_body->length,
+                           .food_size   = p_game->food.size,
+                           .empty_size  = p_game->empty_cells.size };
+
+    // memcpy rather than a cast, the caller's buffer may be unaligned
+    (void)memcpy(p_buf, &state, sizeof(state));
+    (void)memcpy((uint8_t *)p_buf + ARENA_ALIGN(sizeof(game_state_t)),
+                 p_game->p_state,
+                 p_game->state_size);
+    status = GAME_OK;
 
-            if (FOOD == p_entity->entity_type)
-            {
-                point_t pos = { .x = rand() % p_game->game_size,
-                                .y = rand() % p_game->game_size };
-                game_add_entity(p_game, pos, g_zero, FOOD);
-                game_place_tile(p_game, pos, FOOD);
-            }
+EXIT:
+    return (status);
+}
 
-            p_game
-                ->p_tile_matrix[(p_entity->pos.y * p_game->game_size)
-                                + p_entity->pos.x]
-                .tile_type
-                = EMPTY;
+int game_restore (game_t * p_game, const void * p_buf, size_t size)
+{
+    int          status = GAME_GENERAL;
+    game_state_t state  = { 0 };
 
-            game_add_entity(p_game, p_snake_tail->pos, g_zero, PLAYER);
-            game_place_tile(p_game, p_snake_tail->pos, PLAYER);
-            dyn_arr_remove(p_game->p_entity_arr, entity_idx);
-            break;
-        }
+    if ((NULL == p_game) || (NULL == p_buf))
+    {
+        status = GAME_NULL;
+        goto EXIT;
     }
 
-    game_place_tile(p_game, p_snake_head->pos, PLAYER);
-    game_print_score(p_game);
-    should_update = true;
+    if (sizeof(state) > size)
+    {
+        status = GAME_SIZE;
+        goto EXIT;
+    }
+
+    (void)memcpy(&state, p_buf, sizeof(state));
+
+    if ((state.width != p_game->width) || (state.height != p_game->height)
+        || (state.state_size != p_game->state_size))
+    {
+        status = GAME_MISMATCH;
+        goto EXIT;
+    }
+
+    if (game_snapshot_size(p_game) > size)
+    {
+        status = GAME_SIZE;
+        goto EXIT;
+    }
+
+    (void)memcpy(p_game->p_state,
+                 (const uint8_t *)p_buf + ARENA_ALIGN(sizeof(game_state_t)),
+                 p_game->state_size);
+
+    p_game->seed             = state.seed;
+    p_game->rng              = state.rng;
+    p_game->hash             = state.hash;
+    p_game->dir              = state.dir;
+    p_game->score            = state.score;
+    p_game->is_over          = state.is_over;
+    p_game->p_body->head     = state.body_head;
+    p_game->p_body->tail     = state.body_tail;
+    p_game->p_body->length   = state.body_length;
+    p_game->food.size        = state.food_size;
+    p_game->empty_cells.size = state.empty_size;
+
+    if ((NULL != p_game->renderer.draw_tile)
+        || (NULL != p_game->renderer.draw_score))
+    {
+        game_renderer_t renderer = p_game->renderer;
+
+        game_set_renderer(p_game, &renderer);
+    }
+
+    status = GAME_OK;
+
 EXIT:
-    return (should_update);
+    return (status);
+}
+
+entity_type_t game_get_tile (const game_t * p_game, point_t pos)
+{
+    entity_type_t type = EMPTY;
+
+    if ((NULL == p_game) || !game_is_on_board(p_game, pos))
+    {
+        goto EXIT;
+    }
+
+    type = tiles_get(&p_game->tiles, game_cell(p_game, pos));
+
+EXIT:
+    return (type);
+}
+
+size_t game_get_width (const game_t * p_game)
+{
+    return (NULL == p_game) ? 0 : p_game->width;
+}
+
+size_t game_get_height (const game_t * p_game)
+{
+    return (NULL == p_game) ? 0 : p_game->height;
+}
+
+uint64_t game_get_seed (const game_t * p_game)
+{
+    return (NULL == p_game) ? 0 : p_game->seed;
+}
+
+int game_get_score (const game_t * p_game)
+{
+    return (NULL == p_game) ? 0 : p_game->score;
+}
+
+size_t game_get_length (const game_t * p_game)
+{
+    return (NULL == p_game) ? 0 : body_length(p_game->p_body);
+}
+
+point_t game_get_head (const game_t * p_game)
+{
+    return (NULL == p_game) ? (point_t) { 0 } : body_head(p_game->p_body);
+}
+
+point_t game_get_dir (const game_t * p_game)
+{
+    return (NULL == p_game) ? (point_t) { 0 } : p_game->dir;
+}
+
+size_t game_get_food_count (const game_t * p_game)
+{
+    return (NULL == p_game) ? 0 : p_game->food.size;
+}
+
+point_t game_get_food (const game_t * p_game, size_t idx)
+{
+    point_t pos = { 0 };
+
+    if ((NULL == p_game) || (p_game->food.size <= idx))
+    {
+        goto EXIT;
+    }
+
+    pos = p_game->food.p_items[idx].pos;
+
+EXIT:
+    return (pos);
+}
+
+bool game_is_over (const game_t * p_game)
+{
+    return (NULL == p_game) ? true : p_game->is_over;
 }
 
 /*** end of file ***/
@@ -0,0 +1,183 @@
+/**
+ * @file input.c
+ * @author Daniel Chung
+ * @brief Keyboard input parsing and queueing implementation
+ * @version 0.1
+ * @date 2024-03-25
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/input.h"
+
+static void input_push (input_t * p_input, point_t dir)
+{
+    size_t tail = atomic_load_explicit(&(p_input->tail), memory_order_relaxed);
+    size_t head = atomic_load_explicit(&(p_input->head), memory_order_acquire);
+
+    if (INPUT_QUEUE_SIZE == tail - head)
+    {
+        goto EXIT;
+    }
+
+    if (tail != head)
+    {
+        point_t last = p_input->queue[(tail - 1) & (INPUT_QUEUE_SIZE - 1)];
+
+        if ((last.x == dir.x) && (last.y == dir.y))
+        {
+            goto EXIT;
+        }
+    }
+
+    p_input->queue[tail & (INPUT_QUEUE_SIZE - 1)] = dir;
+    atomic_store_explicit(&(p_input->tail), tail + 1, memory_order_release);
+
+EXIT:
+    return;
+}
+
+static void input_parse (input_t * p_input, char chr)
+{
+    point_t dir = { 0 };
+
+    switch (p_input->state)
+    {
+        case INPUT_STATE_ESC:
+            // both ESC [ and ESC O introduce arrow keys
+            if (('[' == chr) || ('O' == chr))
+            {
+                p_input->state = INPUT_STATE_CSI;
+                goto EXIT;
+            }
+
+            p_input->state = INPUT_STATE_GROUND;
+            break;
+        case INPUT_STATE_CSI:
+            p_input->state = INPUT_STATE_GROUND;
+
+            switch (chr)
+            {
+                case 'A':
+                    dir.y = -1;
+                    break;
+                case 'B':
+                    dir.y = 1;
+                    break;
+                case 'C':
+                    dir.x = 1;
+                    break;
+                case 'D':
+                    dir.x = -1;
+                    break;
+                default:
+                    break;
+            }
+
+            goto PUSH;
+        default:
+            break;
+    }
+
+    switch (chr)
+    {
+        case INPUT_KEY_QUIT:
+            p_input->b_should_quit = true;
+            break;
+        case INPUT_KEY_ESC:
+            p_input->state = INPUT_STATE_ESC;
+            break;
+        case MOVEMENT_KEY_UP:
+            dir.y = -1;
+            break;
+        case MOVEMENT_KEY_DOWN:
+            dir.y = 1;
+            break;
+        case MOVEMENT_KEY_RIGHT:
+            dir.x = 1;
+            break;
+        case MOVEMENT_KEY_LEFT:
+            dir.x = -1;
+            break;
+        default:
+            break;
+    }
+
+PUSH:
+    if ((0 != dir.x) || (0 != dir.y))
+    {
+        input_push(p_input, dir);
+    }
+
+EXIT:
+    return;
+}
+
+void input_init (input_t * p_input, int fd)
+{
+    if (NULL == p_input)
+    {
+        goto EXIT;
+    }
+
+    p_input->fd            = fd;
+    p_input->state         = INPUT_STATE_GROUND;
+    p_input->b_should_quit = false;
+    atomic_init(&(p_input->head), 0);
+    atomic_init(&(p_input->tail), 0);
+
+EXIT:
+    return;
+}
+
+bool input_read (input_t * p_input)
+{
+    char    chr[INPUT_READ_SIZE] = { 0 };
+    ssize_t bytes_read           = 0;
+
+    if (NULL == p_input)
+    {
+        goto EXIT;
+    }
+
+    while (0 < (bytes_read = read(p_input->fd, chr, sizeof(chr))))
+    {
+        for (ssize_t idx = 0; idx < bytes_read; idx++)
+        {
+            input_parse(p_input, chr[idx]);
+        }
+    }
+
+EXIT:
+    return (NULL != p_input) && p_input->b_should_quit;
+}
+
+bool input_pop (input_t * p_input, point_t * p_dir)
+{
+    bool   b_is_popped = false;
+    size_t head        = 0;
+    size_t tail        = 0;
+
+    if ((NULL == p_input) || (NULL == p_dir))
+    {
+        goto EXIT;
+    }
+
+    head = atomic_load_explicit(&(p_input->head), memory_order_relaxed);
+    tail = atomic_load_explicit(&(p_input->tail), memory_order_acquire);
+
+    if (head == tail)
+    {
+        goto EXIT;
+    }
+
+    *p_dir = p_input->queue[head & (INPUT_QUEUE_SIZE - 1)];
+    atomic_store_explicit(&(p_input->head), head + 1, memory_order_release);
+    b_is_popped = true;
+
+EXIT:
+    return (b_is_popped);
+}
+
+/*** end of file ***/
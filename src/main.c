@@ -1,83 +1,444 @@
 #include "../include/main.h"
 
-static _Atomic bool gb_run = true;
+static volatile sig_atomic_t g_resized = 0;
 
-int main (void)
+static void main_on_resize (int signum)
 {
-    int status = term_uncook();
+    (void)signum;
+    g_resized = 1;
+}
 
-    if (0 != status)
+/**
+ * @brief Gets a seed that differs between runs, for when -s is not given
+ */
+static uint64_t main_default_seed (void)
+{
+    struct timespec now = { 0 };
+
+    (void)clock_gettime(CLOCK_REALTIME, &now);
+
+    return ((uint64_t)now.tv_sec * NSEC_PER_SEC) + (uint64_t)now.tv_nsec
+           + ((uint64_t)getpid() << 32);
+}
+
+static void main_usage (const char * p_name)
+{
+    (void)fprintf(stderr,
+                  "Usage: %s [-t ticks per second] [-w width] [-h height] "
+                  "[-s seed] [-r record file] [-p replay file [-v]] "
+                  "[-b batch games [-j threads]]\n",
+                  p_name);
+}
+
+/**
+ * @brief Parses a whole option argument as an unsigned number
+ *
+ * @note strtoull skips leading space and negates a leading minus, so the
+ * argument has to start with a digit.
+ *
+ * @param p_arg Argument to parse
+ * @param base Base as for strtoull, 0 to also take 0x and 0 prefixes
+ * @param p_value Receives the number
+ * @retval true if the whole argument is a number that fits in 64 bits
+ * @retval false otherwise
+ */
+static bool main_parse_number (const char * p_arg, int base, uint64_t * p_value)
+{
+    bool   b_is_valid = false;
+    char * p_end      = NULL;
+
+    if ((NULL == p_arg) || !isdigit((unsigned char)p_arg[0]))
     {
         goto EXIT;
     }
 
-    term_clear();
+    errno      = 0;
+    *p_value   = (uint64_t)strtoull(p_arg, &p_end, base);
+    b_is_valid = (0 == errno) && ('\0' == *p_end);
 
-    // game_t * p_game = game_init(BOARD_SIZE);
-    game_t * p_game = game_init(20);
+EXIT:
+    return b_is_valid;
+}
 
-    if (NULL == p_game)
+/**
+ * @brief Plays a headless batch with the greedy bot and prints the totals
+ *
+ * @param p_config Pointer to batch to run
+ * @retval BATCH_OK on success (0)
+ * @retval non-zero on failure
+ */
+static int main_run_batch (batch_config_t * p_config)
+{
+    batch_stats_t   stats = { 0 };
+    struct timespec start = { 0 };
+    struct timespec end   = { 0 };
+
+    p_config->policy    = batch_policy_greedy;
+    p_config->max_ticks = p_config->width * p_config->height
+                          * BATCH_TICKS_PER_CELL;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &start);
+    int status = batch_run(p_config, NULL, &stats);
+    (void)clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if ((BATCH_OK != status) || (0 == stats.games))
     {
-        goto COOK_EXIT;
+        goto EXIT;
     }
 
-    // system("clear");
-    // game_print_tiles(p_game);
+    double elapsed = (double)(end.tv_sec - start.tv_sec)
+                     + ((double)(end.tv_nsec - start.tv_nsec) / NSEC_PER_SEC);
+
+    printf("games,threads,avg_score,max_score,avg_length,max_length,ticks,"
+           "seconds,games_per_sec\n");
+    printf("%zu,%zu,%.2f,%d,%.2f,%zu,%llu,%.3f,%.0f\n",
+           stats.games,
+           p_config->thread_count,
+           (double)stats.total_score / (double)stats.games,
+           stats.max_score,
+           (double)stats.total_length / (double)stats.games,
+           stats.max_length,
+           (unsigned long long)stats.total_ticks,
+           elapsed,
+           (double)stats.games / elapsed);
 
-    for (;;)
+EXIT:
+    return status;
+}
+
+/**
+ * @brief Prints how a replayed game compares to its recording
+ *
+ * @param p_replay Pointer to the recording played
+ * @param p_game Pointer to the game it was played into
+ * @retval REPLAY_OK if the game ended where the recording did (0)
+ * @retval non-zero otherwise
+ */
+static int main_report_replay (const replay_t * p_replay, const game_t * p_game)
+{
+    int          status   = replay_verify(p_replay, p_game);
+    const char * p_result = "mismatch";
+
+    if (REPLAY_OK == status)
+    {
+        p_result = "match";
+    }
+    else if (REPLAY_TRUNCATED == status)
+    {
+        p_result = "no footer to check, recording was cut short";
+    }
+    else if (REPLAY_FORMAT == status)
     {
-        game_tick(p_game);
-        // if (game_tick(p_game))
-        // {
-            // game_print_tiles(p_game);
-        // }
+        p_result = "recording is corrupt";
+    }
 
-        char chr[3] = { 0 };
+    printf("Replayed %llu ticks, score %d, hash %016llx: %s\n",
+           (unsigned long long)p_replay->tick,
+           game_get_score(p_game),
+           (unsigned long long)game_get_hash(p_game),
+           p_result);
 
-        ssize_t bytes_read = 0;
+    if (REPLAY_MISMATCH == status)
+    {
+        printf("Recorded %llu ticks, score %d, hash %016llx\n",
+               (unsigned long long)p_replay->ticks,
+               p_replay->score,
+               (unsigned long long)p_replay->hash);
+    }
 
-        bytes_read = read(STDIN_FILENO, &chr, 3);
+    return status;
+}
 
-        if (0 > bytes_read)
-            continue;
+/**
+ * @brief Plays a recording back headless, as fast as it will go
+ *
+ * @param p_replay Pointer to recording to play
+ * @retval REPLAY_OK if the game ended where the recording did (0)
+ * @retval non-zero otherwise
+ */
+static int main_run_replay (replay_t * p_replay)
+{
+    int      status = REPLAY_GENERAL;
+    game_t * p_game
+        = game_init(p_replay->width, p_replay->height, p_replay->seed);
 
-        if (3 == chr[0])
-        {
-            printf("Exiting...\n");
-            break;
-        }
+    if (NULL == p_game)
+    {
+        goto EXIT;
+    }
+
+    while (!game_is_over(p_game) && !replay_is_done(p_replay))
+    {
+        game_step(p_game, replay_next(p_replay));
+    }
+
+    status = main_report_replay(p_replay, p_game);
+    game_destroy(&p_game);
+
+EXIT:
+    return status;
+}
+
+int main (int argc, char ** argv)
+{
+    int      status     = -1;
+    uint64_t tick_rate  = DEFAULT_TICK_RATE;
+    uint64_t width      = DEFAULT_BOARD_WIDTH;
+    uint64_t height     = DEFAULT_BOARD_HEIGHT;
+    uint64_t seed       = main_default_seed();
+    uint64_t games      = 0;
+    uint64_t threads    = 1;
+    long     online     = sysconf(_SC_NPROCESSORS_ONLN);
+    int      opt        = 0;
+    bool     b_watch    = false;
+    bool     b_is_batch = false;
+    bool     b_is_valid = true;
 
-        point_t xy_delta = { 0 };
+    const char * p_record_path = NULL;
+    const char * p_replay_path = NULL;
+    replay_t *   p_record      = NULL;
+    replay_t *   p_replay      = NULL;
 
-        switch (chr[0])
+    if (0 < online)
+    {
+        threads = (BATCH_MAX_THREADS < online) ? BATCH_MAX_THREADS
+                                               : (uint64_t)online;
+    }
+
+    while (-1 != (opt = getopt(argc, argv, "t:w:h:s:b:j:r:p:v")))
+    {
+        switch (opt)
         {
-            case MOVEMENT_KEY_UP:
-                xy_delta.y = -1;
+            case 't':
+                b_is_valid = main_parse_number(optarg, 10, &tick_rate);
+                break;
+            case 'w':
+                b_is_valid = main_parse_number(optarg, 10, &width);
+                break;
+            case 'h':
+                b_is_valid = main_parse_number(optarg, 10, &height);
                 break;
-            case MOVEMENT_KEY_DOWN:
-                xy_delta.y = 1;
+            case 's':
+                b_is_valid = main_parse_number(optarg, 0, &seed);
                 break;
-            case MOVEMENT_KEY_RIGHT:
-                xy_delta.x = 1;
+            case 'b':
+                b_is_valid = main_parse_number(optarg, 10, &games);
+                b_is_batch = true;
                 break;
-            case MOVEMENT_KEY_LEFT:
-                xy_delta.x = -1;
+            case 'j':
+                b_is_valid = main_parse_number(optarg, 10, &threads);
+                break;
+            case 'r':
+                p_record_path = optarg;
+                break;
+            case 'p':
+                p_replay_path = optarg;
+                break;
+            case 'v':
+                b_watch = true;
                 break;
             default:
+                b_is_valid = false;
                 break;
         }
 
-        if (xy_delta.x != 0 || xy_delta.y != 0)
+        if (!b_is_valid)
         {
-            game_turn_player(p_game, xy_delta);
-            // game_print_tiles(p_game);
+            main_usage(argv[0]);
+            goto EXIT;
         }
     }
 
-    game_destroy(&p_game);
+    if ((0 == tick_rate) || (MAX_TICK_RATE < tick_rate))
+    {
+        (void)fprintf(stderr, "Tick rate must be 1 to %d\n", MAX_TICK_RATE);
+        goto EXIT;
+    }
+
+    if (b_is_batch && ((0 == games) || (UINT32_MAX < games)))
+    {
+        (void)fprintf(stderr, "Batch must be 1 to %u games\n", UINT32_MAX);
+        goto EXIT;
+    }
+
+    if ((0 == threads) || (BATCH_MAX_THREADS < threads))
+    {
+        (void)fprintf(stderr, "Threads must be 1 to %d\n", BATCH_MAX_THREADS);
+        goto EXIT;
+    }
+
+    if ((GAME_MIN_WIDTH > width) || (GAME_MIN_HEIGHT > height)
+        || (GAME_MAX_SIZE < width) || (GAME_MAX_SIZE < height))
+    {
+        (void)fprintf(stderr,
+                      "Board must be %d to %d wide and %d to %d high\n",
+                      GAME_MIN_WIDTH,
+                      GAME_MAX_SIZE,
+                      GAME_MIN_HEIGHT,
+                      GAME_MAX_SIZE);
+        goto EXIT;
+    }
+
+    if (b_is_batch)
+    {
+        batch_config_t config = { .width        = (size_t)width,
+                                  .height       = (size_t)height,
+                                  .base_seed    = seed,
+                                  .game_count   = (size_t)games,
+                                  .thread_count = (size_t)threads };
+
+        status = main_run_batch(&config);
+        profile_dump(stderr);
+        goto EXIT;
+    }
+
+    if (NULL != p_replay_path)
+    {
+        p_replay = replay_play_create(p_replay_path);
+
+        if (NULL == p_replay)
+        {
+            goto EXIT;
+        }
+
+        if (!b_watch)
+        {
+            status = main_run_replay(p_replay);
+            goto EXIT;
+        }
+
+        width  = p_replay->width;
+        height = p_replay->height;
+        seed   = p_replay->seed;
+    }
+
+    status = term_uncook();
+
+    if (0 != status)
+    {
+        goto EXIT;
+    }
+
+    term_clear();
+
+    game_t * p_game = game_init((size_t)width, (size_t)height, seed);
+
+    if (NULL == p_game)
+    {
+        goto COOK_EXIT;
+    }
+
+    if (NULL != p_record_path)
+    {
+        p_record = replay_record_create(p_record_path, p_game);
+
+        if (NULL == p_record)
+        {
+            game_destroy(&p_game);
+            goto COOK_EXIT;
+        }
+    }
+
+    term_renderer_t * p_term
+        = term_renderer_create(game_get_width(p_game), game_get_height(p_game));
+
+    if (NULL == p_term)
+    {
+        game_destroy(&p_game);
+        goto COOK_EXIT;
+    }
+
+    game_set_renderer(p_game, &(p_term->renderer));
+    term_renderer_follow(p_term, game_get_head(p_game));
+    term_renderer_present(p_term);
+    (void)signal(SIGWINCH, main_on_resize);
+    profile_install();
+
+    timestep_t step  = { 0 };
+    input_t    input = { 0 };
+    (void)timestep_init(&step, (uint32_t)tick_rate);
+    input_init(&input, STDIN_FILENO);
+
+    while (!game_is_over(p_game)
+           && ((NULL == p_replay) || !replay_is_done(p_replay)))
+    {
+        // sleeps until the next tick unless a key wakes it first
+        if (timestep_wait(&step, input.fd))
+        {
+            PROFILE_BEGIN(PROFILE_INPUT);
+            bool b_should_quit = input_read(&input);
+            PROFILE_END(PROFILE_INPUT);
+
+            if (b_should_quit)
+            {
+                printf("Exiting...\n");
+                break;
+            }
+        }
+
+        bool b_has_ticked = false;
+
+        // a late wake catches up several ticks, but none past the end of the
+        // game or the recording, or the tick counts would drift apart
+        while (!game_is_over(p_game)
+               && ((NULL == p_replay) || !replay_is_done(p_replay))
+               && timestep_is_due(&step))
+        {
+            // one queued turn per tick so quick combos are not merged
+            point_t dir = { 0 };
+
+            if (NULL != p_replay)
+            {
+                // keys still quit, but turns come from the recording
+                dir = replay_next(p_replay);
+            }
+            else
+            {
+                (void)input_pop(&input, &dir);
+            }
+
+            game_step(p_game, dir);
+            (void)replay_record(p_record, dir);
+            b_has_ticked = true;
+        }
+
+        if (g_resized)
+        {
+            g_resized = 0;
+            term_renderer_invalidate(p_term);
+            b_has_ticked = true;
+        }
+
+        if (b_has_ticked)
+        {
+            PROFILE_BEGIN(PROFILE_PRESENT);
+            term_renderer_follow(p_term, game_get_head(p_game));
+            term_renderer_present(p_term);
+            PROFILE_END(PROFILE_PRESENT);
+        }
+
+        profile_poll(stderr);
+    }
+
+    if (NULL != p_record)
+    {
+        (void)replay_finish(p_record, p_game);
+    }
+
+    term_renderer_destroy(&p_term);
 
 COOK_EXIT:
     status = term_cook();
+    profile_dump(stderr);
+
+    if ((NULL != p_replay) && (NULL != p_game))
+    {
+        status = main_report_replay(p_replay, p_game);
+    }
+
+    game_destroy(&p_game);
 EXIT:
+    replay_destroy(&p_record);
+    replay_destroy(&p_replay);
     return status;
-}
\ No newline at end of file
+}
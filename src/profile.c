@@ -0,0 +1,282 @@
+/**
+ * @file profile.c
+ * @author Daniel Chung
+ * @brief Log-linear histograms behind the tick profiler
+ * @version 0.1
+ * @date 2024-04-05
+ *
+ * A sample below PROFILE_SUB_COUNT gets its own bucket. Above that, the
+ * position of the top bit picks a row and the next PROFILE_SUB_BITS bits pick
+ * the bucket in it, the same layout HdrHistogram uses.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/profile.h"
+
+#ifdef PROFILE
+
+#include <signal.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+
+/**
+ * @brief Histogram of one phase
+ *
+ * @param profile_hist_t::counts Samples per bucket
+ * @param profile_hist_t::total Count of samples
+ * @param profile_hist_t::max Largest sample, exact
+ */
+typedef struct profile_hist_t
+{
+    uint64_t counts[PROFILE_BUCKETS];
+    uint64_t total;
+    uint64_t max;
+} profile_hist_t;
+
+/**
+ * @brief Histograms of every phase, written by one thread only
+ *
+ * @note Only the owning thread writes, so a relaxed load and store is enough
+ * to count and no locked instruction is needed. The atomics are there so a
+ * dump on another thread reads whole values.
+ *
+ * @param profile_set_t::counts Samples per bucket of each phase
+ * @param profile_set_t::totals Count of samples of each phase
+ * @param profile_set_t::maxes Largest sample of each phase
+ * @param profile_set_t::p_next Set of the thread that recorded before this one
+ */
+typedef struct profile_set_t
+{
+    _Atomic uint64_t       counts[PROFILE_PHASE_COUNT][PROFILE_BUCKETS];
+    _Atomic uint64_t       totals[PROFILE_PHASE_COUNT];
+    _Atomic uint64_t       maxes[PROFILE_PHASE_COUNT];
+    struct profile_set_t * p_next;
+} profile_set_t;
+
+static const char * const gp_phase_names[PROFILE_PHASE_COUNT] = {
+    [PROFILE_INPUT]   = "input",
+    [PROFILE_TICK]    = "tick",
+    [PROFILE_COLLIDE] = "collide",
+    [PROFILE_MOVE]    = "move",
+    [PROFILE_SPAWN]   = "spawn",
+    [PROFILE_PLACE]   = "place",
+    [PROFILE_PRESENT] = "present",
+    [PROFILE_FLUSH]   = "flush",
+};
+
+// sets are kept until exit, so a dump still counts threads that finished
+static _Atomic(profile_set_t *)      gp_sets          = NULL;
+static _Thread_local profile_set_t * tp_set           = NULL;
+static volatile sig_atomic_t         g_dump_requested = 0;
+
+static size_t profile_bucket (uint64_t nsec)
+{
+    size_t bucket = (size_t)nsec;
+
+    if (PROFILE_SUB_COUNT <= nsec)
+    {
+        int shift = (63 - __builtin_clzll(nsec)) - PROFILE_SUB_BITS;
+
+        bucket = ((size_t)(shift + 1) * PROFILE_SUB_COUNT)
+                 + (size_t)((nsec >> shift) & (PROFILE_SUB_COUNT - 1));
+    }
+
+    return bucket;
+}
+
+/**
+ * @brief Gets the highest value that lands in a bucket
+ */
+static uint64_t profile_bucket_value (size_t bucket)
+{
+    uint64_t value = (uint64_t)bucket;
+
+    if (PROFILE_SUB_COUNT <= bucket)
+    {
+        int      shift = (int)(bucket / PROFILE_SUB_COUNT) - 1;
+        uint64_t low   = (uint64_t)(bucket % PROFILE_SUB_COUNT);
+
+        value = (((PROFILE_SUB_COUNT + low) << shift) + (UINT64_C(1) << shift))
+                - 1;
+    }
+
+    return value;
+}
+
+/**
+ * @brief Gets the value at a percentile
+ *
+ * @param p_hist Pointer to histogram
+ * @param permille Percentile in tenths of a percent, 999 for p99.9
+ * @return uint64_t Value in nanoseconds, capped at the exact max
+ */
+static uint64_t profile_percentile (const profile_hist_t * p_hist,
+                                    uint64_t               permille)
+{
+    uint64_t value  = 0;
+    uint64_t target = ((p_hist->total * permille) + 999) / 1000;
+    uint64_t seen   = 0;
+
+    for (size_t bucket = 0; bucket < PROFILE_BUCKETS; bucket++)
+    {
+        seen += p_hist->counts[bucket];
+
+        if ((0 < seen) && (target <= seen))
+        {
+            value = profile_bucket_value(bucket);
+            break;
+        }
+    }
+
+    return (value < p_hist->max) ? value : p_hist->max;
+}
+
+/**
+ * @brief Gets the calling thread's set, making it on first use
+ *
+ * @retval profile_set_t* Pointer to the set
+ * @retval NULL if it could not be allocated, the sample is then dropped
+ */
+static profile_set_t * profile_thread_set (void)
+{
+    if (NULL == tp_set)
+    {
+        tp_set = (profile_set_t *)calloc(1, sizeof(profile_set_t));
+
+        if (NULL != tp_set)
+        {
+            tp_set->p_next = atomic_load(&gp_sets);
+
+            // pushed once per thread, a failed swap has reloaded p_next
+            while (!atomic_compare_exchange_weak(
+                &gp_sets, &tp_set->p_next, tp_set))
+            {
+            }
+        }
+    }
+
+    return tp_set;
+}
+
+static inline void profile_add (_Atomic uint64_t * p_value, uint64_t amount)
+{
+    atomic_store_explicit(
+        p_value,
+        atomic_load_explicit(p_value, memory_order_relaxed) + amount,
+        memory_order_relaxed);
+}
+
+/**
+ * @brief Sums one phase over the sets of every thread
+ */
+static void profile_merge (profile_phase_t phase, profile_hist_t * p_hist)
+{
+    *p_hist = (profile_hist_t) { 0 };
+
+    profile_set_t * p_set = atomic_load(&gp_sets);
+
+    for (; NULL != p_set; p_set = p_set->p_next)
+    {
+        for (size_t bucket = 0; bucket < PROFILE_BUCKETS; bucket++)
+        {
+            p_hist->counts[bucket] += atomic_load_explicit(
+                &p_set->counts[phase][bucket], memory_order_relaxed);
+        }
+
+        uint64_t max
+            = atomic_load_explicit(&p_set->maxes[phase], memory_order_relaxed);
+
+        p_hist->total += atomic_load_explicit(&p_set->totals[phase],
+                                              memory_order_relaxed);
+        p_hist->max = (p_hist->max < max) ? max : p_hist->max;
+    }
+}
+
+static void profile_on_signal (int signum)
+{
+    (void)signum;
+    g_dump_requested = 1;
+}
+
+void profile_record (profile_phase_t phase, uint64_t nsec)
+{
+    profile_set_t * p_set = NULL;
+
+    if (PROFILE_PHASE_COUNT <= phase)
+    {
+        goto EXIT;
+    }
+
+    p_set = profile_thread_set();
+
+    if (NULL == p_set)
+    {
+        goto EXIT;
+    }
+
+    profile_add(&p_set->counts[phase][profile_bucket(nsec)], 1);
+    profile_add(&p_set->totals[phase], 1);
+
+    _Atomic uint64_t * p_max = &p_set->maxes[phase];
+
+    if (atomic_load_explicit(p_max, memory_order_relaxed) < nsec)
+    {
+        atomic_store_explicit(p_max, nsec, memory_order_relaxed);
+    }
+
+EXIT:
+    return;
+}
+
+void profile_dump (FILE * p_file)
+{
+    (void)fprintf(p_file,
+                  "%-8s %10s %10s %10s %10s %10s\n",
+                  "phase",
+                  "count",
+                  "p50_ns",
+                  "p99_ns",
+                  "p999_ns",
+                  "max_ns");
+
+    // merged one phase at a time, a whole merged set would be 50 KB
+    profile_hist_t   hist   = { 0 };
+    profile_hist_t * p_hist = &hist;
+
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++)
+    {
+        profile_merge((profile_phase_t)phase, p_hist);
+
+        (void)fprintf(p_file,
+                      "%-8s %10llu %10llu %10llu %10llu %10llu\n",
+                      gp_phase_names[phase],
+                      (unsigned long long)p_hist->total,
+                      (unsigned long long)profile_percentile(p_hist, 500),
+                      (unsigned long long)profile_percentile(p_hist, 990),
+                      (unsigned long long)profile_percentile(p_hist, 999),
+                      (unsigned long long)p_hist->max);
+    }
+
+    (void)fflush(p_file);
+}
+
+void profile_install (void)
+{
+    (void)signal(SIGUSR1, profile_on_signal);
+}
+
+void profile_poll (FILE * p_file)
+{
+    if (g_dump_requested)
+    {
+        g_dump_requested = 0;
+        profile_dump(p_file);
+    }
+}
+
+#endif // PROFILE
+
+/*** end of file ***/
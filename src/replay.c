@@ -0,0 +1,436 @@
+/**
+ * @file replay.c
+ * @author Daniel Chung
+ * @brief Recording of a game's inputs and playing them back
+ * @version 0.1
+ * @date 2024-04-13
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/replay.h"
+
+#include <string.h>
+
+#define REPLAY_MAGIC_SIZE  4
+#define REPLAY_VARINT_MAX  10
+#define REPLAY_DIR_BITS    2
+#define REPLAY_DIR_MASK    ((1u << REPLAY_DIR_BITS) - 1)
+
+// input codes are indices into this table
+static const point_t g_replay_dirs[] = {
+    { 1, 0 },
+    { 0, 1 },
+    { -1, 0 },
+    { 0, -1 },
+};
+
+static bool replay_write_u64 (FILE * p_file, uint64_t value, size_t size)
+{
+    uint8_t bytes[sizeof(uint64_t)] = { 0 };
+
+    for (size_t idx = 0; idx < size; idx++)
+    {
+        bytes[idx] = (uint8_t)(value >> (8 * idx));
+    }
+
+    return (size == fwrite(bytes, 1, size, p_file));
+}
+
+static bool replay_read_u64 (FILE * p_file, uint64_t * p_value, size_t size)
+{
+    uint8_t bytes[sizeof(uint64_t)] = { 0 };
+    bool    b_is_read = (size == fread(bytes, 1, size, p_file));
+
+    *p_value = 0;
+
+    for (size_t idx = 0; b_is_read && (idx < size); idx++)
+    {
+        *p_value |= (uint64_t)bytes[idx] << (8 * idx);
+    }
+
+    return (b_is_read);
+}
+
+/**
+ * @brief Writes a value 7 bits per byte, low bits first, high bit set on
+ * every byte but the last
+ */
+static bool replay_write_varint (FILE * p_file, uint64_t value)
+{
+    uint8_t bytes[REPLAY_VARINT_MAX] = { 0 };
+    size_t  size                     = 0;
+
+    do
+    {
+        bytes[size] = (uint8_t)(value & 0x7F);
+        value >>= 7;
+        bytes[size] |= (0 != value) ? 0x80 : 0;
+        size++;
+    } while (0 != value);
+
+    return (size == fwrite(bytes, 1, size, p_file));
+}
+
+static bool replay_read_varint (FILE * p_file, uint64_t * p_value)
+{
+    bool b_is_read = false;
+
+    *p_value = 0;
+
+    for (size_t idx = 0; idx < REPLAY_VARINT_MAX; idx++)
+    {
+        int byte = fgetc(p_file);
+
+        if (EOF == byte)
+        {
+            break;
+        }
+
+        *p_value |= (uint64_t)(byte & 0x7F) << (7 * idx);
+
+        if (0 == (byte & 0x80))
+        {
+            b_is_read = true;
+            break;
+        }
+    }
+
+    return (b_is_read);
+}
+
+/**
+ * @brief Reads the turn after the one just played, or the footer
+ *
+ * @note A file that ends early leaves no turn ahead and no footer. A turn that
+ * cannot have been recorded marks the recording corrupt and ends it there.
+ */
+static void replay_read_turn (replay_t * p_replay)
+{
+    uint64_t input = 0;
+
+    p_replay->b_has_next = false;
+
+    if (!replay_read_varint(p_replay->p_file, &input))
+    {
+        goto EXIT;
+    }
+
+    if (0 == input)
+    {
+        uint64_t score = 0;
+
+        p_replay->b_has_footer
+            = replay_read_varint(p_replay->p_file, &p_replay->ticks)
+              && replay_read_varint(p_replay->p_file, &score)
+              && replay_read_u64(
+                  p_replay->p_file, &p_replay->hash, sizeof(uint64_t));
+        p_replay->score = (int)score;
+        goto EXIT;
+    }
+
+    // the tick count is since the turn after the last one, so it is never 0
+    if (0 == (input >> REPLAY_DIR_BITS))
+    {
+        (void)fprintf(stderr, "Recording has a turn 0 ticks after the last\n");
+        p_replay->b_is_corrupt = true;
+        goto EXIT;
+    }
+
+    p_replay->next_tick  = p_replay->turn_tick + (input >> REPLAY_DIR_BITS) - 1;
+    p_replay->next_dir   = g_replay_dirs[input & REPLAY_DIR_MASK];
+    p_replay->turn_tick  = p_replay->next_tick + 1;
+    p_replay->b_has_next = true;
+
+EXIT:
+    return;
+}
+
+replay_t * replay_record_create (const char * p_path, const game_t * p_game)
+{
+    replay_t * p_replay = NULL;
+
+    if ((NULL == p_path) || (NULL == p_game))
+    {
+        (void)fprintf(stderr, "Invalid arguments\n");
+        goto EXIT;
+    }
+
+    p_replay = (replay_t *)calloc(1, sizeof(replay_t));
+
+    if (NULL == p_replay)
+    {
+        perror("calloc");
+        goto EXIT;
+    }
+
+    p_replay->p_file = fopen(p_path, "wb");
+
+    if (NULL == p_replay->p_file)
+    {
+        perror("fopen");
+        free(p_replay);
+        p_replay = NULL;
+        goto EXIT;
+    }
+
+    p_replay->b_is_writing = true;
+    p_replay->seed         = game_get_seed(p_game);
+    p_replay->width        = game_get_width(p_game);
+    p_replay->height       = game_get_height(p_game);
+
+    // GAME_MAX_SIZE fits in the 16 bit size fields
+    if ((REPLAY_MAGIC_SIZE
+         != fwrite(REPLAY_MAGIC, 1, REPLAY_MAGIC_SIZE, p_replay->p_file))
+        || (EOF == fputc(REPLAY_VERSION, p_replay->p_file))
+        || !replay_write_u64(p_replay->p_file, p_replay->seed, sizeof(uint64_t))
+        || !replay_write_u64(p_replay->p_file, p_replay->width, sizeof(uint16_t))
+        || !replay_write_u64(
+            p_replay->p_file, p_replay->height, sizeof(uint16_t))
+        || (0 != fflush(p_replay->p_file)))
+    {
+        perror("fwrite");
+        replay_destroy(&p_replay);
+        goto EXIT;
+    }
+
+EXIT:
+    return (p_replay);
+}
+
+int replay_record (replay_t * p_replay, point_t dir)
+{
+    int status = REPLAY_GENERAL;
+
+    if ((NULL == p_replay) || !p_replay->b_is_writing)
+    {
+        status = REPLAY_NULL;
+        goto EXIT;
+    }
+
+    if ((0 == dir.x) && (0 == dir.y))
+    {
+        p_replay->tick++;
+        status = REPLAY_OK;
+        goto EXIT;
+    }
+
+    size_t code = 0;
+
+    while ((code < (sizeof(g_replay_dirs) / sizeof(g_replay_dirs[0])))
+           && ((g_replay_dirs[code].x != dir.x)
+               || (g_replay_dirs[code].y != dir.y)))
+    {
+        code++;
+    }
+
+    if ((sizeof(g_replay_dirs) / sizeof(g_replay_dirs[0])) == code)
+    {
+        (void)fprintf(stderr, "Cannot record direction %d,%d\n", dir.x, dir.y);
+        status = REPLAY_FORMAT;
+        goto EXIT;
+    }
+
+    uint64_t since = (p_replay->tick + 1) - p_replay->turn_tick;
+
+    // flushed now so a crash still leaves every turn up to it
+    if (!replay_write_varint(p_replay->p_file, (since << REPLAY_DIR_BITS) | code)
+        || (0 != fflush(p_replay->p_file)))
+    {
+        perror("fwrite");
+        status = REPLAY_IO;
+        goto EXIT;
+    }
+
+    p_replay->turn_tick = p_replay->tick + 1;
+    p_replay->tick++;
+    status = REPLAY_OK;
+
+EXIT:
+    return (status);
+}
+
+int replay_finish (replay_t * p_replay, const game_t * p_game)
+{
+    int status = REPLAY_GENERAL;
+
+    if ((NULL == p_replay) || !p_replay->b_is_writing || (NULL == p_game))
+    {
+        status = REPLAY_NULL;
+        goto EXIT;
+    }
+
+    if (!replay_write_varint(p_replay->p_file, 0)
+        || !replay_write_varint(p_replay->p_file, p_replay->tick)
+        || !replay_write_varint(p_replay->p_file,
+                                (uint64_t)game_get_score(p_game))
+        || !replay_write_u64(
+            p_replay->p_file, game_get_hash(p_game), sizeof(uint64_t))
+        || (0 != fflush(p_replay->p_file)))
+    {
+        perror("fwrite");
+        status = REPLAY_IO;
+        goto EXIT;
+    }
+
+    status = REPLAY_OK;
+
+EXIT:
+    return (status);
+}
+
+replay_t * replay_play_create (const char * p_path)
+{
+    replay_t * p_replay = NULL;
+
+    if (NULL == p_path)
+    {
+        (void)fprintf(stderr, "Invalid arguments\n");
+        goto EXIT;
+    }
+
+    p_replay = (replay_t *)calloc(1, sizeof(replay_t));
+
+    if (NULL == p_replay)
+    {
+        perror("calloc");
+        goto EXIT;
+    }
+
+    p_replay->p_file = fopen(p_path, "rb");
+
+    if (NULL == p_replay->p_file)
+    {
+        perror("fopen");
+        free(p_replay);
+        p_replay = NULL;
+        goto EXIT;
+    }
+
+    char     magic[REPLAY_MAGIC_SIZE] = { 0 };
+    uint64_t width                    = 0;
+    uint64_t height                   = 0;
+
+    if ((REPLAY_MAGIC_SIZE
+         != fread(magic, 1, REPLAY_MAGIC_SIZE, p_replay->p_file))
+        || (0 != memcmp(magic, REPLAY_MAGIC, REPLAY_MAGIC_SIZE))
+        || (REPLAY_VERSION != fgetc(p_replay->p_file))
+        || !replay_read_u64(p_replay->p_file, &p_replay->seed, sizeof(uint64_t))
+        || !replay_read_u64(p_replay->p_file, &width, sizeof(uint16_t))
+        || !replay_read_u64(p_replay->p_file, &height, sizeof(uint16_t)))
+    {
+        (void)fprintf(stderr, "%s is not a recording\n", p_path);
+        replay_destroy(&p_replay);
+        goto EXIT;
+    }
+
+    if ((GAME_MIN_WIDTH > width) || (GAME_MIN_HEIGHT > height)
+        || (GAME_MAX_SIZE < width) || (GAME_MAX_SIZE < height))
+    {
+        (void)fprintf(stderr,
+                      "%s has a %llux%llu board, which no game can have\n",
+                      p_path,
+                      (unsigned long long)width,
+                      (unsigned long long)height);
+        replay_destroy(&p_replay);
+        goto EXIT;
+    }
+
+    p_replay->width  = (size_t)width;
+    p_replay->height = (size_t)height;
+    replay_read_turn(p_replay);
+
+EXIT:
+    return (p_replay);
+}
+
+point_t replay_next (replay_t * p_replay)
+{
+    point_t dir = { 0 };
+
+    if ((NULL == p_replay) || p_replay->b_is_writing)
+    {
+        goto EXIT;
+    }
+
+    if (p_replay->b_has_next && (p_replay->next_tick == p_replay->tick))
+    {
+        dir = p_replay->next_dir;
+        replay_read_turn(p_replay);
+    }
+
+    p_replay->tick++;
+
+EXIT:
+    return (dir);
+}
+
+bool replay_is_done (const replay_t * p_replay)
+{
+    bool b_is_done = true;
+
+    if ((NULL == p_replay) || p_replay->b_has_next)
+    {
+        b_is_done = (NULL == p_replay);
+        goto EXIT;
+    }
+
+    b_is_done = !p_replay->b_has_footer || (p_replay->tick >= p_replay->ticks);
+
+EXIT:
+    return (b_is_done);
+}
+
+int replay_verify (const replay_t * p_replay, const game_t * p_game)
+{
+    int status = REPLAY_GENERAL;
+
+    if ((NULL == p_replay) || p_replay->b_is_writing || (NULL == p_game))
+    {
+        status = REPLAY_NULL;
+        goto EXIT;
+    }
+
+    if (p_replay->b_is_corrupt)
+    {
+        status = REPLAY_FORMAT;
+        goto EXIT;
+    }
+
+    if (!p_replay->b_has_footer)
+    {
+        status = REPLAY_TRUNCATED;
+        goto EXIT;
+    }
+
+    bool b_is_match = (p_replay->tick == p_replay->ticks)
+                      && (p_replay->score == game_get_score(p_game))
+                      && (p_replay->hash == game_get_hash(p_game));
+
+    status = b_is_match ? REPLAY_OK : REPLAY_MISMATCH;
+
+EXIT:
+    return (status);
+}
+
+void replay_destroy (replay_t ** pp_replay)
+{
+    if ((NULL == pp_replay) || (NULL == *pp_replay))
+    {
+        goto EXIT;
+    }
+
+    if (NULL != (*pp_replay)->p_file)
+    {
+        (void)fclose((*pp_replay)->p_file);
+    }
+
+    free(*pp_replay);
+    *pp_replay = NULL;
+
+EXIT:
+    return;
+}
+
+/*** end of file ***/
@@ -0,0 +1,43 @@
+/**
+ * @file rng.c
+ * @author Daniel Chung
+ * @brief Seeding for the xoshiro256** generator
+ * @version 0.1
+ * @date 2024-04-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/rng.h"
+
+/**
+ * @brief Steps splitmix64, used only to spread a seed over the state
+ */
+static uint64_t rng_splitmix (uint64_t * p_x)
+{
+    uint64_t z = (*p_x += UINT64_C(0x9E3779B97F4A7C15));
+
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+
+    return z ^ (z >> 31);
+}
+
+void rng_seed (rng_t * p_rng, uint64_t seed)
+{
+    if (NULL == p_rng)
+    {
+        goto EXIT;
+    }
+
+    for (size_t idx = 0; idx < 4; idx++)
+    {
+        p_rng->state[idx] = rng_splitmix(&seed);
+    }
+
+EXIT:
+    return;
+}
+
+/*** end of file ***/
@@ -1,9 +1,10 @@
 /**
  * @file sll.c
  * @author Daniel Chung
- * @brief Implementation of threadsafe singly linked list
+ * @brief Implementation of threadsafe doubly linked list
  *
- * TODO: additional notes
+ * Nodes carry a back link as well, so both ends unlink in constant time and
+ * positional walks start from whichever end is closer.
  *
  * @version 0.1
  * @date 2024-03-06
@@ -15,9 +16,53 @@
 #include "../include/sll.h"
 
 static sll_node_t * sll_node_create (void * p_data);
+static sll_node_t * sll_node_at (sll_t * p_sll, const size_t index);
 
 /**
- * @brief Creates a new singly linked list on heap
+ * @brief Lock helpers that do nothing for an unsynchronized list
+ *
+ * @param p_sll Pointer to doubly linked list
+ * @retval 0 on success, or always for an unsynchronized list
+ * @retval non-zero pthread error otherwise
+ */
+static inline int sll_rdlock (sll_t * p_sll)
+{
+    int status = 0;
+
+    if (p_sll->b_is_synced)
+    {
+        status = pthread_rwlock_rdlock(&(p_sll->sll_rwlock));
+    }
+
+    return status;
+}
+
+static inline int sll_wrlock (sll_t * p_sll)
+{
+    int status = 0;
+
+    if (p_sll->b_is_synced)
+    {
+        status = pthread_rwlock_wrlock(&(p_sll->sll_rwlock));
+    }
+
+    return status;
+}
+
+static inline int sll_unlock (sll_t * p_sll)
+{
+    int status = 0;
+
+    if (p_sll->b_is_synced)
+    {
+        status = pthread_rwlock_unlock(&(p_sll->sll_rwlock));
+    }
+
+    return status;
+}
+
+/**
+ * @brief Creates a new doubly linked list on heap
  *
  * @note cmp_func can be NULL
  *
@@ -49,6 +94,7 @@ sll_t * sll_create (sll_cmp_f cmp_func)
     p_new_sll->p_tail        = NULL;
     p_new_sll->size          = 0;
     p_new_sll->node_cmp_func = cmp_func;
+    p_new_sll->b_is_synced   = true;
 
     if (0 != pthread_rwlock_init(&p_new_sll->sll_rwlock, NULL))
     {
@@ -62,12 +108,34 @@ EXIT:
 }
 
 /**
- * @brief Destroys a singly linked list
+ * @brief Creates a new doubly linked list that never takes its rwlock
+ *
+ * @note Same API as a locked list. Only use it from a single thread.
+ *
+ * @param cmp_func Function pointer to compare node data, can be NULL
+ * @return sll_t*
+ * @retval Pointer to new sll on success
+ * @retval NULL on failure
+ */
+sll_t * sll_create_unsync (sll_cmp_f cmp_func)
+{
+    sll_t * p_new_sll = sll_create(cmp_func);
+
+    if (NULL != p_new_sll)
+    {
+        p_new_sll->b_is_synced = false;
+    }
+
+    return (p_new_sll);
+}
+
+/**
+ * @brief Destroys a doubly linked list
  *
  * @note Sets sll pointer to NULL after destruction
- * @note You must free data in the singly linked list separately
+ * @note You must free data in the doubly linked list separately
  *
- * @param p_sll Pointer to singly linked list
+ * @param p_sll Pointer to doubly linked list
  * @return int
  * @retval SLL_OK on success (0)
  * @retval nonzero otherwise
@@ -82,12 +150,12 @@ int sll_destroy (sll_t ** pp_sll)
 
     if ((NULL == pp_sll) || (NULL == *pp_sll))
     {
-        (void)fprintf(stderr, "Pointer to singly linked list cannot be NULL\n");
+        (void)fprintf(stderr, "Pointer to doubly linked list cannot be NULL\n");
         status = SLL_NULL;
         goto EXIT;
     }
 
-    if (0 != pthread_rwlock_wrlock(&((*pp_sll)->sll_rwlock)))
+    if (0 != sll_wrlock(*pp_sll))
     {
         perror("Failed to acquire write lock\n");
         status = SLL_RWLOCK;
@@ -102,7 +170,7 @@ int sll_destroy (sll_t ** pp_sll)
         p_current = NULL;
     }
 
-    if (0 != pthread_rwlock_unlock(&((*pp_sll)->sll_rwlock)))
+    if (0 != sll_unlock(*pp_sll))
     {
         perror("Failed to release write lock\n");
         status = SLL_RWLOCK;
@@ -125,9 +193,9 @@ EXIT:
 }
 
 /**
- * @brief Prepends a new node to the singly linked list
+ * @brief Prepends a new node to the doubly linked list
  *
- * @param p_sll Pointer to singly linked list
+ * @param p_sll Pointer to doubly linked list
  * @param p_data Pointer to data to prepend
  * @param b_is_locked Whether to acquire the write lock
  *
@@ -146,14 +214,14 @@ int sll_prepend (sll_t * p_sll, void * p_data, const bool b_is_locked)
     if ((NULL == p_sll) || (NULL == p_data))
     {
         (void)fprintf(stderr,
-                      "Pointer to singly linked list or data cannot be NULL\n");
+                      "Pointer to doubly linked list or data cannot be NULL\n");
         status = SLL_NULL;
         goto EXIT;
     }
 
     if (!b_is_locked)
     {
-        if (0 != pthread_rwlock_wrlock(&(p_sll->sll_rwlock)))
+        if (0 != sll_wrlock(p_sll))
         {
             perror("Failed to acquire write lock\n");
             status = SLL_RWLOCK;
@@ -175,6 +243,10 @@ int sll_prepend (sll_t * p_sll, void * p_data, const bool b_is_locked)
     {
         p_sll->p_tail = p_new_node;
     }
+    else
+    {
+        p_sll->p_head->p_prev = p_new_node;
+    }
 
     p_new_node->p_next = p_sll->p_head;
     p_sll->p_head      = p_new_node;
@@ -184,7 +256,7 @@ int sll_prepend (sll_t * p_sll, void * p_data, const bool b_is_locked)
 EXIT_UNLOCK:
     if (!b_is_locked)
     {
-        if (0 != pthread_rwlock_unlock(&(p_sll->sll_rwlock)))
+        if (0 != sll_unlock(p_sll))
         {
             perror("Failed to release write lock\n");
             status = SLL_RWLOCK;
@@ -197,9 +269,9 @@ EXIT:
 }
 
 /**
- * @brief Appends a new node to the singly linked list
+ * @brief Appends a new node to the doubly linked list
  *
- * @param p_sll Pointer to singly linked list
+ * @param p_sll Pointer to doubly linked list
  * @param p_data Pointer to data to append
  * @param b_is_locked Whether to acquire the write lock
  * @return int
@@ -218,14 +290,14 @@ int sll_append (sll_t * p_sll, void * p_data, const bool b_is_locked)
     if ((NULL == p_sll) || (NULL == p_data))
     {
         (void)fprintf(stderr,
-                      "Pointer to singly linked list or data cannot be NULL\n");
+                      "Pointer to doubly linked list or data cannot be NULL\n");
         status = SLL_NULL;
         goto EXIT;
     }
 
     if (!b_is_locked)
     {
-        if (0 != pthread_rwlock_wrlock(&(p_sll->sll_rwlock)))
+        if (0 != sll_wrlock(p_sll))
         {
             (void)fprintf(stderr, "Failed to acquire write lock\n");
             status = SLL_RWLOCK;
@@ -250,6 +322,7 @@ int sll_append (sll_t * p_sll, void * p_data, const bool b_is_locked)
     else
     {
         p_sll->p_tail->p_next = p_new_node;
+        p_new_node->p_prev    = p_sll->p_tail;
     }
 
     p_sll->p_tail = p_new_node;
@@ -258,10 +331,13 @@ int sll_append (sll_t * p_sll, void * p_data, const bool b_is_locked)
     status = SLL_OK;
 
 EXIT_UNLOCK:
-    if (0 != pthread_rwlock_unlock(&(p_sll->sll_rwlock)))
+    if (!b_is_locked)
     {
-        perror("Failed to release write lock\n");
-        status = SLL_RWLOCK;
+        if (0 != sll_unlock(p_sll))
+        {
+            perror("Failed to release write lock\n");
+            status = SLL_RWLOCK;
+        }
     }
 
 EXIT:
@@ -269,9 +345,9 @@ EXIT:
 }
 
 /**
- * @brief Inserts a new node to the singly linked list at a specific index
+ * @brief Inserts a new node to the doubly linked list at a specific index
  *
- * @param p_sll Pointer to singly linked list
+ * @param p_sll Pointer to doubly linked list
  * @param p_data Pointer to data to insert
  * @param index Index to insert
  * @return int
@@ -289,12 +365,12 @@ int sll_insert (sll_t * p_sll, void * p_data, const size_t index)
     if ((NULL == p_sll) || (NULL == p_data))
     {
         (void)fprintf(stderr,
-                      "Pointer to singly linked list or data cannot be NULL\n");
+                      "Pointer to doubly linked list or data cannot be NULL\n");
         status = SLL_NULL;
         goto EXIT;
     }
 
-    if (0 != pthread_rwlock_wrlock(&(p_sll->sll_rwlock)))
+    if (0 != sll_wrlock(p_sll))
     {
         perror("Failed to acquire write lock\n");
         status = SLL_RWLOCK;
@@ -329,25 +405,20 @@ int sll_insert (sll_t * p_sll, void * p_data, const size_t index)
             goto EXIT_UNLOCK;
         }
 
-        sll_node_t * p_current = p_sll->p_head;
-        size_t       idx       = 0;
-
-        // skip over to the nodes before the index
-        while (idx < index - 1)
-        {
-            p_current = p_current->p_next;
-            idx++;
-        }
+        // the node before the index, neither end since those are above
+        sll_node_t * p_current = sll_node_at(p_sll, index - 1);
 
-        p_new_node->p_next = p_current->p_next;
-        p_current->p_next  = p_new_node;
+        p_new_node->p_prev        = p_current;
+        p_new_node->p_next        = p_current->p_next;
+        p_current->p_next->p_prev = p_new_node;
+        p_current->p_next         = p_new_node;
         p_sll->size++;
     }
 
     status = SLL_OK;
 
 EXIT_UNLOCK:
-    if (0 != pthread_rwlock_unlock(&(p_sll->sll_rwlock)))
+    if (0 != sll_unlock(p_sll))
     {
         perror("Failed to release write lock\n");
         status = SLL_RWLOCK;
@@ -360,14 +431,14 @@ EXIT:
 /**
  * @brief Removes the first node
  *
- * @param p_sll Pointer to singly linked list
+ * @param p_sll Pointer to doubly linked list
  * @param b_is_locked Whether to acquire the write lock
  * @return int
  * @retval SLL_OK on success (0)
  * @retval nonzero otherwise
  * @retval SLL_NULL if p_sll is NULL
  * @retval SLL_RWLOCK if failed to acquire/release write lock
- * @retval SLL_BOUNDS if singly linked list is empty
+ * @retval SLL_BOUNDS if doubly linked list is empty
  * @retval SLL_OK if successful
  *
  */
@@ -377,14 +448,14 @@ int sll_preremove (sll_t * p_sll, const bool b_is_locked)
 
     if (NULL == p_sll)
     {
-        (void)fprintf(stderr, "Pointer to singly linked list cannot be NULL\n");
+        (void)fprintf(stderr, "Pointer to doubly linked list cannot be NULL\n");
         status = SLL_NULL;
         goto EXIT;
     }
 
     if (!b_is_locked)
     {
-        if (0 != pthread_rwlock_wrlock(&(p_sll->sll_rwlock)))
+        if (0 != sll_wrlock(p_sll))
         {
             perror("Failed to acquire write lock\n");
             status = SLL_RWLOCK;
@@ -394,13 +465,23 @@ int sll_preremove (sll_t * p_sll, const bool b_is_locked)
 
     if (NULL == p_sll->p_head)
     {
-        (void)fprintf(stderr, "Singly linked list is empty\n");
+        (void)fprintf(stderr, "Doubly linked list is empty\n");
         status = SLL_BOUNDS;
         goto EXIT_UNLOCK;
     }
 
     sll_node_t * p_current = p_sll->p_head;
     p_sll->p_head          = p_current->p_next;
+
+    if (NULL == p_sll->p_head)
+    {
+        p_sll->p_tail = NULL;
+    }
+    else
+    {
+        p_sll->p_head->p_prev = NULL;
+    }
+
     free(p_current);
     p_current = NULL;
     p_sll->size--;
@@ -410,7 +491,7 @@ int sll_preremove (sll_t * p_sll, const bool b_is_locked)
 EXIT_UNLOCK:
     if (!b_is_locked)
     {
-        if (0 != pthread_rwlock_unlock(&(p_sll->sll_rwlock)))
+        if (0 != sll_unlock(p_sll))
         {
             perror("Failed to release write lock\n");
             status = SLL_RWLOCK;
@@ -424,14 +505,14 @@ EXIT:
 /**
  * @brief Removes the last node
  *
- * @param p_sll Pointer to singly linked list
+ * @param p_sll Pointer to doubly linked list
  * @param b_is_locked Whether to acquire the write lock
  * @return int
  * @retval SLL_OK on success (0)
  * @retval nonzero otherwise
  * @retval SLL_NULL if p_sll is NULL
  * @retval SLL_RWLOCK if failed to acquire/release write lock
- * @retval SLL_BOUNDS if singly linked list is empty
+ * @retval SLL_BOUNDS if doubly linked list is empty
  *
  */
 int sll_postremove (sll_t * p_sll, const bool b_is_locked)
@@ -440,14 +521,14 @@ int sll_postremove (sll_t * p_sll, const bool b_is_locked)
 
     if (NULL == p_sll)
     {
-        (void)fprintf(stderr, "Pointer to singly linked list cannot be NULL\n");
+        (void)fprintf(stderr, "Pointer to doubly linked list cannot be NULL\n");
         status = SLL_NULL;
         goto EXIT;
     }
 
     if (!b_is_locked)
     {
-        if (0 != pthread_rwlock_wrlock(&(p_sll->sll_rwlock)))
+        if (0 != sll_wrlock(p_sll))
         {
             perror("Failed to acquire write lock\n");
             status = SLL_RWLOCK;
@@ -457,20 +538,14 @@ int sll_postremove (sll_t * p_sll, const bool b_is_locked)
 
     if (NULL == p_sll->p_head)
     {
-        (void)fprintf(stderr, "Singly linked list is empty\n");
+        (void)fprintf(stderr, "Doubly linked list is empty\n");
         status = SLL_BOUNDS;
         goto EXIT_UNLOCK;
     }
 
-    sll_node_t * p_current = p_sll->p_head;
-    sll_node_t * p_prev    = NULL;
-
-    // skip over to the last node
-    while (NULL != p_current->p_next)
-    {
-        p_prev    = p_current;
-        p_current = p_current->p_next;
-    }
+    // the back link makes this constant time, no walk to find the new tail
+    sll_node_t * p_current = p_sll->p_tail;
+    sll_node_t * p_prev    = p_current->p_prev;
 
     if (NULL == p_prev)
     {
@@ -491,7 +566,7 @@ int sll_postremove (sll_t * p_sll, const bool b_is_locked)
 EXIT_UNLOCK:
     if (!b_is_locked)
     {
-        if (0 != pthread_rwlock_unlock(&(p_sll->sll_rwlock)))
+        if (0 != sll_unlock(p_sll))
         {
             perror("Failed to release write lock\n");
             status = SLL_RWLOCK;
@@ -505,7 +580,7 @@ EXIT:
 /**
  * @brief Removes a node at a specific index
  *
- * @param p_sll Pointer to singly linked list
+ * @param p_sll Pointer to doubly linked list
  * @param index Index to remove
  * @return int SLL_OK on success (0)
  * @retval nonzero otherwise
@@ -520,12 +595,12 @@ int sll_remove (sll_t * p_sll, const size_t index)
 
     if (NULL == p_sll)
     {
-        (void)fprintf(stderr, "Pointer to singly linked list cannot be NULL\n");
+        (void)fprintf(stderr, "Pointer to doubly linked list cannot be NULL\n");
         status = SLL_NULL;
         goto EXIT;
     }
 
-    if (0 != pthread_rwlock_wrlock(&(p_sll->sll_rwlock)))
+    if (0 != sll_wrlock(p_sll))
     {
         perror("Failed to acquire write lock\n");
         status = SLL_RWLOCK;
@@ -550,18 +625,10 @@ int sll_remove (sll_t * p_sll, const size_t index)
     }
     else
     {
-        sll_node_t * p_current = p_sll->p_head;
-        sll_node_t * p_prev    = NULL;
-        size_t       idx       = 0;
-
-        while (idx < index)
-        {
-            p_prev    = p_current;
-            p_current = p_current->p_next;
-            idx++;
-        }
+        sll_node_t * p_current = sll_node_at(p_sll, index);
 
-        p_prev->p_next = p_current->p_next;
+        p_current->p_prev->p_next = p_current->p_next;
+        p_current->p_next->p_prev = p_current->p_prev;
         free(p_current);
         p_current = NULL;
         p_sll->size--;
@@ -570,7 +637,7 @@ int sll_remove (sll_t * p_sll, const size_t index)
     status = SLL_OK;
 
 EXIT_UNLOCK:
-    if (0 != pthread_rwlock_unlock(&(p_sll->sll_rwlock)))
+    if (0 != sll_unlock(p_sll))
     {
         perror("Failed to release write lock\n");
         status = SLL_RWLOCK;
@@ -583,7 +650,7 @@ EXIT:
 /**
  * @brief Gets the data at a specific index
  *
- * @param p_sll Pointer to singly linked list
+ * @param p_sll Pointer to doubly linked list
  * @param index Index to get
  * @return void*
  * @retval Pointer to data on success
@@ -595,11 +662,11 @@ void * sll_get (sll_t * p_sll, const size_t index)
 
     if (NULL == p_sll)
     {
-        (void)fprintf(stderr, "Pointer to singly linked list cannot be NULL\n");
+        (void)fprintf(stderr, "Pointer to doubly linked list cannot be NULL\n");
         goto EXIT;
     }
 
-    if (0 != pthread_rwlock_rdlock(&(p_sll->sll_rwlock)))
+    if (0 != sll_rdlock(p_sll))
     {
         perror("Failed to acquire read lock\n");
         goto EXIT;
@@ -611,19 +678,10 @@ void * sll_get (sll_t * p_sll, const size_t index)
         goto EXIT_UNLOCK;
     }
 
-    sll_node_t * p_current = p_sll->p_head;
-    size_t       idx       = 0;
-
-    while (idx < index)
-    {
-        p_current = p_current->p_next;
-        idx++;
-    }
-
-    p_data = p_current->p_data;
+    p_data = sll_node_at(p_sll, index)->p_data;
 
 EXIT_UNLOCK:
-    if (0 != pthread_rwlock_unlock(&(p_sll->sll_rwlock)))
+    if (0 != sll_unlock(p_sll))
     {
         perror("Failed to release read lock\n");
         p_data = NULL;
@@ -634,12 +692,12 @@ EXIT:
 }
 
 /**
- * @brief Checks if data is in the singly linked list
+ * @brief Checks if data is in the doubly linked list
  *
- * @param p_sll Pointer to singly linked list
+ * @param p_sll Pointer to doubly linked list
  * @param p_data Pointer to data to check
- * @retval true if data is in the singly linked list
- * @retval false if data is not in the singly linked list
+ * @retval true if data is in the doubly linked list
+ * @retval false if data is not in the doubly linked list
  */
 bool sll_is_in (sll_t * p_sll, const void * p_data)
 {
@@ -648,11 +706,11 @@ bool sll_is_in (sll_t * p_sll, const void * p_data)
     if ((NULL == p_sll) || (NULL == p_data))
     {
         (void)fprintf(stderr,
-                      "Pointer to singly linked list or data cannot be NULL\n");
+                      "Pointer to doubly linked list or data cannot be NULL\n");
         goto EXIT;
     }
 
-    if (0 != pthread_rwlock_rdlock(&(p_sll->sll_rwlock)))
+    if (0 != sll_rdlock(p_sll))
     {
         perror("Failed to acquire read lock\n");
         goto EXIT;
@@ -671,7 +729,7 @@ bool sll_is_in (sll_t * p_sll, const void * p_data)
         p_current = p_current->p_next;
     }
 
-    if (0 != pthread_rwlock_unlock(&(p_sll->sll_rwlock)))
+    if (0 != sll_unlock(p_sll))
     {
         perror("Failed to release read lock\n");
         // b_is_in = false;
@@ -682,11 +740,11 @@ EXIT:
 }
 
 /**
- * @brief Checks if singly linked list is empty
+ * @brief Checks if doubly linked list is empty
  *
- * @param p_sll Pointer to singly linked list
- * @retval true if singly linked list is empty
- * @retval false if singly linked list is not empty
+ * @param p_sll Pointer to doubly linked list
+ * @retval true if doubly linked list is empty
+ * @retval false if doubly linked list is not empty
  */
 bool sll_is_empty (sll_t * p_sll)
 {
@@ -694,11 +752,11 @@ bool sll_is_empty (sll_t * p_sll)
 
     if (NULL == p_sll)
     {
-        (void)fprintf(stderr, "Pointer to singly linked list cannot be NULL\n");
+        (void)fprintf(stderr, "Pointer to doubly linked list cannot be NULL\n");
         goto EXIT;
     }
 
-    if (0 != pthread_rwlock_rdlock(&(p_sll->sll_rwlock)))
+    if (0 != sll_rdlock(p_sll))
     {
         perror("Failed to acquire read lock");
         goto EXIT;
@@ -706,7 +764,7 @@ bool sll_is_empty (sll_t * p_sll)
 
     b_is_empty = (NULL == p_sll->p_head);
 
-    if (0 != pthread_rwlock_unlock(&(p_sll->sll_rwlock)))
+    if (0 != sll_unlock(p_sll))
     {
         perror("Failed to release read lock");
         // b_is_empty = false;
@@ -717,11 +775,11 @@ EXIT:
 }
 
 /**
- * @brief Gets the size of the singly linked list
+ * @brief Gets the size of the doubly linked list
  *
- * @param p_sll Pointer to singly linked list
+ * @param p_sll Pointer to doubly linked list
  * @return size_t
- * @retval Size of singly linked list
+ * @retval Size of doubly linked list
  */
 size_t sll_size (sll_t * p_sll)
 {
@@ -729,11 +787,11 @@ size_t sll_size (sll_t * p_sll)
 
     if (NULL == p_sll)
     {
-        (void)fprintf(stderr, "Pointer to singly linked list cannot be NULL\n");
+        (void)fprintf(stderr, "Pointer to doubly linked list cannot be NULL\n");
         goto EXIT;
     }
 
-    if (0 != pthread_rwlock_rdlock(&(p_sll->sll_rwlock)))
+    if (0 != sll_rdlock(p_sll))
     {
         perror("Failed to acquire read lock");
         goto EXIT;
@@ -741,7 +799,7 @@ size_t sll_size (sll_t * p_sll)
 
     size = p_sll->size;
 
-    if (0 != pthread_rwlock_unlock(&(p_sll->sll_rwlock)))
+    if (0 != sll_unlock(p_sll))
     {
         perror("Failed to release read lock");
         size = 0;
@@ -752,7 +810,85 @@ EXIT:
 }
 
 /**
- * @brief Creates a new singly linked list node on heap
+ * @brief Gets the data of the first node
+ *
+ * @param p_sll Pointer to doubly linked list
+ * @return void*
+ * @retval Pointer to data on success
+ * @retval NULL if the list is empty or on failure
+ */
+void * sll_peek_head (sll_t * p_sll)
+{
+    void * p_data = NULL;
+
+    if (NULL == p_sll)
+    {
+        (void)fprintf(stderr, "Pointer to doubly linked list cannot be NULL\n");
+        goto EXIT;
+    }
+
+    if (0 != sll_rdlock(p_sll))
+    {
+        perror("Failed to acquire read lock\n");
+        goto EXIT;
+    }
+
+    if (NULL != p_sll->p_head)
+    {
+        p_data = p_sll->p_head->p_data;
+    }
+
+    if (0 != sll_unlock(p_sll))
+    {
+        perror("Failed to release read lock\n");
+        p_data = NULL;
+    }
+
+EXIT:
+    return p_data;
+}
+
+/**
+ * @brief Gets the data of the last node
+ *
+ * @param p_sll Pointer to doubly linked list
+ * @return void*
+ * @retval Pointer to data on success
+ * @retval NULL if the list is empty or on failure
+ */
+void * sll_peek_tail (sll_t * p_sll)
+{
+    void * p_data = NULL;
+
+    if (NULL == p_sll)
+    {
+        (void)fprintf(stderr, "Pointer to doubly linked list cannot be NULL\n");
+        goto EXIT;
+    }
+
+    if (0 != sll_rdlock(p_sll))
+    {
+        perror("Failed to acquire read lock\n");
+        goto EXIT;
+    }
+
+    if (NULL != p_sll->p_tail)
+    {
+        p_data = p_sll->p_tail->p_data;
+    }
+
+    if (0 != sll_unlock(p_sll))
+    {
+        perror("Failed to release read lock\n");
+        p_data = NULL;
+    }
+
+EXIT:
+    return p_data;
+}
+
+/**
+ * @brief Creates a new doubly linked list node on heap
  *
  * @param p_data Pointer to data to store in node
  * @retval sll_node_t* Pointer to new node on success
@@ -778,9 +914,45 @@ static sll_node_t * sll_node_create (void * p_data)
 
     p_new_node->p_data = p_data;
     p_new_node->p_next = NULL;
+    p_new_node->p_prev = NULL;
 
 EXIT:
     return p_new_node;
 }
 
+/**
+ * @brief Gets the node at an index, walking from the closer end
+ *
+ * @note The caller holds the lock and has checked index against size.
+ *
+ * @param p_sll Pointer to doubly linked list
+ * @param index Index of node
+ * @retval sll_node_t* Pointer to node
+ */
+static sll_node_t * sll_node_at (sll_t * p_sll, const size_t index)
+{
+    sll_node_t * p_current = NULL;
+
+    if (index < (p_sll->size / 2))
+    {
+        p_current = p_sll->p_head;
+
+        for (size_t idx = 0; idx < index; idx++)
+        {
+            p_current = p_current->p_next;
+        }
+    }
+    else
+    {
+        p_current = p_sll->p_tail;
+
+        for (size_t idx = p_sll->size - 1; idx > index; idx--)
+        {
+            p_current = p_current->p_prev;
+        }
+    }
+
+    return p_current;
+}
+
 /*** end of file ***/
@@ -81,4 +81,19 @@ void term_show_cursor (void)
     fflush(stdout);
 }
 
+void term_get_size (int * p_cols, int * p_rows)
+{
+    struct winsize size = { 0 };
+
+    if ((0 > ioctl(STDOUT_FILENO, TIOCGWINSZ, &size)) || (0 == size.ws_col)
+        || (0 == size.ws_row))
+    {
+        size.ws_col = TERM_DEFAULT_COLS;
+        size.ws_row = TERM_DEFAULT_ROWS;
+    }
+
+    *p_cols = size.ws_col;
+    *p_rows = size.ws_row;
+}
+
 /*** end of file ***/
\ No newline at end of file
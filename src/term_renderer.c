@@ -0,0 +1,318 @@
+/**
+ * @file term_renderer.c
+ * @author Daniel Chung
+ * @brief Terminal front end for the game renderer interface
+ * @version 0.1
+ * @date 2024-03-18
+ *
+ * Tile and score changes reported by the game core only land in the back
+ * buffer. term_renderer_present diffs it against the front buffer, collects
+ * the changed cells into a frame buffer and sends it with a single write().
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/term_renderer.h"
+#include "../include/profile.h"
+
+static const char * term_renderer_icon (entity_type_t type)
+{
+    const char * p_icon = GAME_ICON_EMPTY;
+
+    switch (type)
+    {
+        case EMPTY:
+            p_icon = GAME_ICON_EMPTY;
+            break;
+        case PLAYER:
+            p_icon = GAME_ICON_PLAYER;
+            break;
+        case FOOD:
+            p_icon = GAME_ICON_FOOD;
+            break;
+        default:
+            break;
+    }
+
+    return (p_icon);
+}
+
+static void term_renderer_draw_tile (void *        p_ctx,
+                                     point_t       pos,
+                                     entity_type_t type)
+{
+    term_renderer_t * p_term = (term_renderer_t *)p_ctx;
+
+    p_term->p_back[((size_t)pos.y * p_term->width) + (size_t)pos.x]
+        = (uint8_t)type;
+}
+
+static void term_renderer_draw_score (void * p_ctx, int score)
+{
+    term_renderer_t * p_term = (term_renderer_t *)p_ctx;
+
+    p_term->back_score = score;
+}
+
+/**
+ * @brief Buffers the changed cells of one row
+ *
+ * @param p_term Pointer to renderer
+ * @param row Row to diff
+ */
+static void term_renderer_diff_row (term_renderer_t * p_term, size_t row)
+{
+    uint8_t * p_back   = p_term->p_back + (row * p_term->width);
+    uint8_t * p_front  = p_term->p_front + (row * p_term->width);
+    size_t    col      = p_term->view_x;
+    size_t    col_end  = p_term->view_x + p_term->view_width;
+    size_t    run_end  = 0;
+    bool      b_in_run = false;
+
+    for (; col < col_end; col++)
+    {
+        if (p_back[col] == p_front[col])
+        {
+            continue;
+        }
+
+        // bridge short gaps of unchanged cells, it is cheaper than a goto
+        if (!b_in_run || (col - run_end > TERM_RUN_GAP))
+        {
+            (void)frame_goto(p_term->p_frame,
+                             ((col - p_term->view_x) * OFFSET) + 1,
+                             (row - p_term->view_y) + 1);
+            run_end = col;
+        }
+
+        for (; run_end < col; run_end++)
+        {
+            (void)frame_puts(p_term->p_frame,
+                             term_renderer_icon(p_back[run_end]));
+        }
+
+        (void)frame_puts(p_term->p_frame, term_renderer_icon(p_back[col]));
+        p_front[col] = p_back[col];
+        run_end      = col + 1;
+        b_in_run     = true;
+    }
+}
+
+/**
+ * @brief Sizes the view to the terminal and keeps it on the board
+ *
+ * @param p_term Pointer to renderer
+ */
+static void term_renderer_fit_view (term_renderer_t * p_term)
+{
+    int cols = 0;
+    int rows = 0;
+
+    term_get_size(&cols, &rows);
+
+    size_t view_width  = (OFFSET <= cols) ? (size_t)(cols / OFFSET) : 1;
+    size_t view_height = (TERM_STATUS_ROWS < rows)
+                             ? (size_t)(rows - TERM_STATUS_ROWS)
+                             : 1;
+
+    p_term->view_width
+        = (view_width < p_term->width) ? view_width : p_term->width;
+    p_term->view_height
+        = (view_height < p_term->height) ? view_height : p_term->height;
+
+    if (p_term->view_x + p_term->view_width > p_term->width)
+    {
+        p_term->view_x = p_term->width - p_term->view_width;
+    }
+
+    if (p_term->view_y + p_term->view_height > p_term->height)
+    {
+        p_term->view_y = p_term->height - p_term->view_height;
+    }
+}
+
+/**
+ * @brief Gets the view origin along one axis that keeps pos in sight
+ *
+ * @param origin Current origin
+ * @param view Length of the view
+ * @param board Length of the board
+ * @param pos Position to keep in sight
+ * @return size_t The current origin if pos is comfortably inside, otherwise
+ * one that centers pos as far as the board allows
+ */
+static size_t term_renderer_scroll (size_t origin,
+                                    size_t view,
+                                    size_t board,
+                                    size_t pos)
+{
+    size_t margin = view / 4;
+
+    if ((pos < origin + margin) || (pos >= origin + view - margin))
+    {
+        origin = (pos > view / 2) ? pos - (view / 2) : 0;
+
+        if (origin + view > board)
+        {
+            origin = board - view;
+        }
+    }
+
+    return origin;
+}
+
+term_renderer_t * term_renderer_create (size_t width, size_t height)
+{
+    term_renderer_t * p_new_term = NULL;
+
+    p_new_term = (term_renderer_t *)calloc(1, sizeof(term_renderer_t));
+
+    if (NULL == p_new_term)
+    {
+        perror("malloc");
+        goto EXIT;
+    }
+
+    p_new_term->width  = width;
+    p_new_term->height = height;
+    term_renderer_fit_view(p_new_term);
+
+    // room for every cell in view to change in one frame, plus the score
+    // line. A bigger view after a resize just flushes early.
+    p_new_term->p_frame = frame_create(
+        STDOUT_FILENO,
+        (p_new_term->view_width * p_new_term->view_height
+         * (FRAME_GOTO_MAX + OFFSET))
+            + 64);
+    p_new_term->p_back  = (uint8_t *)calloc(width * height, 1);
+    p_new_term->p_front = (uint8_t *)calloc(width * height, 1);
+
+    if ((NULL == p_new_term->p_frame) || (NULL == p_new_term->p_back)
+        || (NULL == p_new_term->p_front))
+    {
+        perror("malloc");
+        term_renderer_destroy(&p_new_term);
+        goto EXIT;
+    }
+
+    p_new_term->b_is_stale          = true;
+    p_new_term->renderer.p_ctx      = p_new_term;
+    p_new_term->renderer.draw_tile  = term_renderer_draw_tile;
+    p_new_term->renderer.draw_score = term_renderer_draw_score;
+
+EXIT:
+    return (p_new_term);
+}
+
+void term_renderer_destroy (term_renderer_t ** pp_term)
+{
+    if ((NULL == pp_term) || (NULL == *pp_term))
+    {
+        goto EXIT;
+    }
+
+    frame_destroy(&((*pp_term)->p_frame));
+    free((*pp_term)->p_back);
+    free((*pp_term)->p_front);
+    free(*pp_term);
+    *pp_term = NULL;
+
+EXIT:
+    return;
+}
+
+int term_renderer_present (term_renderer_t * p_term)
+{
+    int status = FRAME_GENERAL;
+
+    if (NULL == p_term)
+    {
+        status = FRAME_NULL;
+        goto EXIT;
+    }
+
+    if (p_term->b_is_stale)
+    {
+        term_renderer_fit_view(p_term);
+
+        // make every cell in view differ from the back buffer, then clear
+        // the screen
+        for (size_t row = p_term->view_y;
+             row < p_term->view_y + p_term->view_height;
+             row++)
+        {
+            size_t start = (row * p_term->width) + p_term->view_x;
+
+            for (size_t cell = start; cell < start + p_term->view_width;
+                 cell++)
+            {
+                p_term->p_front[cell] = (uint8_t)~p_term->p_back[cell];
+            }
+        }
+
+        frame_forget_cursor(p_term->p_frame);
+        (void)frame_puts(p_term->p_frame, "\033[H\033[J");
+        frame_forget_cursor(p_term->p_frame);
+        p_term->front_score = ~p_term->back_score;
+        p_term->b_is_stale  = false;
+    }
+
+    for (size_t row = p_term->view_y;
+         row < p_term->view_y + p_term->view_height;
+         row++)
+    {
+        term_renderer_diff_row(p_term, row);
+    }
+
+    if (p_term->back_score != p_term->front_score)
+    {
+        char line[32] = { 0 };
+
+        (void)snprintf(line, sizeof(line), "Score: %d", p_term->back_score);
+        (void)frame_goto(
+            p_term->p_frame, 1, p_term->view_height + TERM_STATUS_ROWS);
+        (void)frame_puts(p_term->p_frame, line);
+        p_term->front_score = p_term->back_score;
+    }
+
+    PROFILE_BEGIN(PROFILE_FLUSH);
+    status = frame_flush(p_term->p_frame);
+    PROFILE_END(PROFILE_FLUSH);
+
+EXIT:
+    return (status);
+}
+
+void term_renderer_invalidate (term_renderer_t * p_term)
+{
+    if (NULL != p_term)
+    {
+        p_term->b_is_stale = true;
+    }
+}
+
+void term_renderer_follow (term_renderer_t * p_term, point_t pos)
+{
+    if ((NULL == p_term) || (0 > pos.x) || (0 > pos.y))
+    {
+        goto EXIT;
+    }
+
+    size_t view_x = term_renderer_scroll(
+        p_term->view_x, p_term->view_width, p_term->width, (size_t)pos.x);
+    size_t view_y = term_renderer_scroll(
+        p_term->view_y, p_term->view_height, p_term->height, (size_t)pos.y);
+
+    if ((view_x != p_term->view_x) || (view_y != p_term->view_y))
+    {
+        p_term->view_x     = view_x;
+        p_term->view_y     = view_y;
+        p_term->b_is_stale = true;
+    }
+
+EXIT:
+    return;
+}
+
+/*** end of file ***/
@@ -0,0 +1,23 @@
+/**
+ * @file tiles.c
+ * @author Daniel Chung
+ * @brief Packed tile matrix implementation
+ * @version 0.1
+ * @date 2024-04-08
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/tiles.h"
+
+void tiles_init (tiles_t * p_tiles, uint64_t * p_words, const size_t size)
+{
+    if (NULL != p_tiles)
+    {
+        p_tiles->p_words = p_words;
+        p_tiles->size    = size;
+    }
+}
+
+/*** end of file ***/
@@ -0,0 +1,107 @@
+/**
+ * @file timestep.c
+ * @author Daniel Chung
+ * @brief Fixed timestep scheduling implementation
+ * @version 0.1
+ * @date 2024-03-22
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/timestep.h"
+
+static int64_t timestep_diff_nsec (const struct timespec * p_end,
+                                   const struct timespec * p_start)
+{
+    return ((int64_t)(p_end->tv_sec - p_start->tv_sec) * NSEC_PER_SEC)
+           + (p_end->tv_nsec - p_start->tv_nsec);
+}
+
+static void timestep_add_nsec (struct timespec * p_time, int64_t nsec)
+{
+    p_time->tv_sec += nsec / NSEC_PER_SEC;
+    p_time->tv_nsec += nsec % NSEC_PER_SEC;
+
+    if (NSEC_PER_SEC <= p_time->tv_nsec)
+    {
+        p_time->tv_sec++;
+        p_time->tv_nsec -= NSEC_PER_SEC;
+    }
+}
+
+int timestep_init (timestep_t * p_step, uint32_t tick_rate)
+{
+    int status = -1;
+
+    if ((NULL == p_step) || (0 == tick_rate))
+    {
+        goto EXIT;
+    }
+
+    if (0 != clock_gettime(CLOCK_MONOTONIC, &(p_step->next_tick)))
+    {
+        perror("clock_gettime");
+        goto EXIT;
+    }
+
+    p_step->period_nsec = NSEC_PER_SEC / tick_rate;
+    timestep_add_nsec(&(p_step->next_tick), p_step->period_nsec);
+    status = 0;
+
+EXIT:
+    return (status);
+}
+
+bool timestep_wait (timestep_t * p_step, int fd)
+{
+    bool            b_is_readable = false;
+    struct timespec now           = { 0 };
+    struct timespec timeout       = { 0 };
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t remaining = timestep_diff_nsec(&(p_step->next_tick), &now);
+
+    if (0 < remaining)
+    {
+        timeout.tv_sec  = remaining / NSEC_PER_SEC;
+        timeout.tv_nsec = remaining % NSEC_PER_SEC;
+    }
+
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+
+    // a negative fd is ignored by ppoll, so this is a plain sleep
+    if ((0 < ppoll(&pfd, 1, &timeout, NULL)) && (pfd.revents & POLLIN))
+    {
+        b_is_readable = true;
+    }
+
+    return (b_is_readable);
+}
+
+bool timestep_is_due (timestep_t * p_step)
+{
+    bool            b_is_due = false;
+    struct timespec now      = { 0 };
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t behind = timestep_diff_nsec(&now, &(p_step->next_tick));
+
+    if (0 > behind)
+    {
+        goto EXIT;
+    }
+
+    if ((TIMESTEP_MAX_BEHIND * p_step->period_nsec) < behind)
+    {
+        p_step->next_tick = now;
+    }
+
+    timestep_add_nsec(&(p_step->next_tick), p_step->period_nsec);
+    b_is_due = true;
+
+EXIT:
+    return (b_is_due);
+}
+
+/*** end of file ***/
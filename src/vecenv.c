@@ -0,0 +1,489 @@
+/**
+ * @file vecenv.c
+ * @author Daniel Chung
+ * @brief Many games of one board size stepped together
+ * @version 0.1
+ * @date 2024-04-12
+ *
+ * A step runs in three passes. Turning applies each game's input. Advancing
+ * works out, from the struct of arrays fields and one tile lookup, where each
+ * head goes and what happens there, 8 games at a time on CPUs with AVX2.
+ * Committing then applies those events game by game in the same order
+ * game_tick does, so both draw the same food from the same generator.
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/vecenv.h"
+#include "../include/game.h"
+
+#include <string.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define VECENV_HAS_AVX2 1
+#endif
+
+#define VECENV_LANES 8
+
+static inline tiles_t vecenv_tiles (const vecenv_t * p_env, size_t idx)
+{
+    return (tiles_t) { .p_words = &p_env->p_tile_words[idx * p_env->tile_words],
+                       .size    = p_env->cells };
+}
+
+/**
+ * @brief Sets a tile of one game and keeps its empty set in step
+ */
+static void vecenv_place (vecenv_t *    p_env,
+                          size_t        idx,
+                          size_t        cell,
+                          entity_type_t type)
+{
+    tiles_t tiles = vecenv_tiles(p_env, idx);
+
+    tiles_set(&tiles, cell, type);
+
+    if (EMPTY == type)
+    {
+        cellset_insert(&p_env->p_empty[idx], cell);
+    }
+    else
+    {
+        cellset_remove(&p_env->p_empty[idx], cell);
+    }
+}
+
+static void vecenv_push_head (vecenv_t * p_env, size_t idx, size_t cell)
+{
+    uint32_t * p_ring = &p_env->p_rings[idx * p_env->cells];
+    uint32_t   head   = p_env->p_ring_head[idx] + 1;
+
+    head                     = (head == p_env->cells) ? 0 : head;
+    p_ring[head]             = (uint32_t)cell;
+    p_env->p_ring_head[idx]  = head;
+    p_env->p_head_x[idx]     = (int32_t)(cell % p_env->width);
+    p_env->p_head_y[idx]     = (int32_t)(cell / p_env->width);
+    p_env->p_length[idx]++;
+    vecenv_place(p_env, idx, cell, PLAYER);
+}
+
+static void vecenv_pop_tail (vecenv_t * p_env, size_t idx)
+{
+    uint32_t * p_ring = &p_env->p_rings[idx * p_env->cells];
+    uint32_t   tail   = p_env->p_ring_tail[idx];
+
+    vecenv_place(p_env, idx, p_ring[tail], EMPTY);
+    tail                     = (tail + 1 == p_env->cells) ? 0 : tail + 1;
+    p_env->p_ring_tail[idx]  = tail;
+    p_env->p_tail_cell[idx]  = (int32_t)p_ring[tail];
+    p_env->p_length[idx]--;
+}
+
+/**
+ * @brief Puts food on a random empty cell of one game
+ *
+ * @retval true if food was placed
+ * @retval false if the board is full
+ */
+static bool vecenv_spawn_food (vecenv_t * p_env, size_t idx)
+{
+    bool        b_is_placed = false;
+    cellset_t * p_empty     = &p_env->p_empty[idx];
+
+    if (0 < p_empty->size)
+    {
+        size_t cell = cellset_at(
+            p_empty, rng_below(&p_env->p_rngs[idx], p_empty->size));
+
+        vecenv_place(p_env, idx, cell, FOOD);
+        b_is_placed = true;
+    }
+
+    return (b_is_placed);
+}
+
+/**
+ * @brief Works out the next cell and event of a range of games
+ *
+ * @note The reference for the AVX2 kernel, and what handles the games left
+ * over after its last full group of lanes.
+ */
+static void vecenv_advance (vecenv_t * p_env, size_t begin, size_t end)
+{
+    for (size_t idx = begin; idx < end; idx++)
+    {
+        int32_t x = p_env->p_head_x[idx] + p_env->p_dir_x[idx];
+        int32_t y = p_env->p_head_y[idx] + p_env->p_dir_y[idx];
+
+        p_env->p_next_cell[idx] = -1;
+
+        if (p_env->p_is_over[idx])
+        {
+            p_env->p_event[idx] = VECENV_IDLE;
+            continue;
+        }
+
+        if (((uint32_t)x >= p_env->width) || ((uint32_t)y >= p_env->height))
+        {
+            p_env->p_event[idx] = VECENV_HIT_WALL;
+            continue;
+        }
+
+        int32_t       cell  = (y * (int32_t)p_env->width) + x;
+        tiles_t       tiles = vecenv_tiles(p_env, idx);
+        entity_type_t tile  = tiles_get(&tiles, (size_t)cell);
+
+        p_env->p_next_cell[idx] = cell;
+
+        if (FOOD == tile)
+        {
+            p_env->p_event[idx] = VECENV_EAT;
+        }
+        else if ((PLAYER == tile) && (cell != p_env->p_tail_cell[idx]))
+        {
+            p_env->p_event[idx] = VECENV_HIT_BODY;
+        }
+        else
+        {
+            p_env->p_event[idx] = VECENV_MOVE;
+        }
+    }
+}
+
+#ifdef VECENV_HAS_AVX2
+/**
+ * @brief vecenv_advance over whole groups of 8 games
+ *
+ * @note Tiles are fetched with one gather per group, reading the 32 bit half
+ * of the tile word that holds each cell. That relies on x86 being little
+ * endian, which this path only ever runs on.
+ *
+ * @return size_t Count of games done, the rest are left to vecenv_advance
+ */
+__attribute__((target("avx2"))) static size_t vecenv_advance_avx2 (
+    vecenv_t * p_env)
+{
+    const __m256i width    = _mm256_set1_epi32((int32_t)p_env->width);
+    const __m256i height   = _mm256_set1_epi32((int32_t)p_env->height);
+    const __m256i none     = _mm256_set1_epi32(-1);
+    const __m256i zero     = _mm256_setzero_si256();
+    const __m256i lanes    = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i stride   = _mm256_set1_epi32((int32_t)(p_env->tile_words * 2));
+    const __m256i low_bits = _mm256_set1_epi32(15);
+    const __m256i mask     = _mm256_set1_epi32((int32_t)TILES_MASK);
+    const __m256i food     = _mm256_set1_epi32(FOOD);
+    const __m256i player   = _mm256_set1_epi32(PLAYER);
+    const int *   p_half_words = (const int *)p_env->p_tile_words;
+    size_t        idx          = 0;
+
+    for (; (idx + VECENV_LANES) <= p_env->count; idx += VECENV_LANES)
+    {
+        __m256i x = _mm256_add_epi32(
+            _mm256_loadu_si256((const __m256i *)&p_env->p_head_x[idx]),
+            _mm256_loadu_si256((const __m256i *)&p_env->p_dir_x[idx]));
+        __m256i y = _mm256_add_epi32(
+            _mm256_loadu_si256((const __m256i *)&p_env->p_head_y[idx]),
+            _mm256_loadu_si256((const __m256i *)&p_env->p_dir_y[idx]));
+        __m256i tail
+            = _mm256_loadu_si256((const __m256i *)&p_env->p_tail_cell[idx]);
+        __m256i running = _mm256_cmpeq_epi32(
+            _mm256_loadu_si256((const __m256i *)&p_env->p_is_over[idx]), zero);
+
+        __m256i on_board = _mm256_and_si256(
+            _mm256_and_si256(_mm256_cmpgt_epi32(x, none),
+                             _mm256_cmpgt_epi32(width, x)),
+            _mm256_and_si256(_mm256_cmpgt_epi32(y, none),
+                             _mm256_cmpgt_epi32(height, y)));
+        __m256i valid = _mm256_and_si256(on_board, running);
+        __m256i cell  = _mm256_add_epi32(_mm256_mullo_epi32(y, width), x);
+
+        // lanes off the board or over are masked out of the gather
+        __m256i game = _mm256_add_epi32(_mm256_set1_epi32((int32_t)idx), lanes);
+        __m256i half = _mm256_add_epi32(_mm256_mullo_epi32(game, stride),
+                                        _mm256_srli_epi32(cell, 4));
+        __m256i word = _mm256_mask_i32gather_epi32(
+            zero, p_half_words, half, valid, sizeof(int32_t));
+        __m256i shift
+            = _mm256_slli_epi32(_mm256_and_si256(cell, low_bits), 1);
+        __m256i tile = _mm256_and_si256(_mm256_srlv_epi32(word, shift), mask);
+
+        __m256i is_food = _mm256_cmpeq_epi32(tile, food);
+        __m256i is_body = _mm256_andnot_si256(_mm256_cmpeq_epi32(cell, tail),
+                                              _mm256_cmpeq_epi32(tile, player));
+        __m256i event   = _mm256_set1_epi32(VECENV_MOVE);
+
+        event = _mm256_blendv_epi8(
+            event, _mm256_set1_epi32(VECENV_EAT), is_food);
+        event = _mm256_blendv_epi8(
+            event, _mm256_set1_epi32(VECENV_HIT_BODY), is_body);
+        event = _mm256_blendv_epi8(
+            _mm256_set1_epi32(VECENV_HIT_WALL), event, on_board);
+        // VECENV_IDLE is 0
+        event = _mm256_and_si256(event, running);
+
+        _mm256_storeu_si256((__m256i *)&p_env->p_next_cell[idx],
+                            _mm256_blendv_epi8(none, cell, valid));
+        _mm256_storeu_si256((__m256i *)&p_env->p_event[idx], event);
+    }
+
+    return idx;
+}
+#endif
+
+/**
+ * @brief Gets the bytes a batch needs from its arena
+ *
+ * @note Must list exactly what vecenv_create allocates from the arena.
+ */
+static size_t vecenv_footprint (size_t count, size_t cells)
+{
+    return ARENA_ALIGN(sizeof(vecenv_t))
+           + (10 * ARENA_ALIGN(count * sizeof(int32_t)))
+           + (2 * ARENA_ALIGN(count * sizeof(uint32_t)))
+           + ARENA_ALIGN(count * cells * sizeof(uint32_t))
+           + ARENA_ALIGN(count * TILES_WORDS(cells) * sizeof(uint64_t))
+           + ARENA_ALIGN(count * sizeof(cellset_t))
+           + (2 * ARENA_ALIGN(count * cells * sizeof(uint32_t)))
+           + ARENA_ALIGN(count * sizeof(rng_t));
+}
+
+vecenv_t * vecenv_create (size_t   count,
+                          size_t   width,
+                          size_t   height,
+                          uint64_t base_seed)
+{
+    vecenv_t * p_env   = NULL;
+    arena_t *  p_arena = NULL;
+    size_t     cells   = width * height;
+
+    if ((0 == count) || (GAME_MIN_WIDTH > width) || (GAME_MIN_HEIGHT > height)
+        || (GAME_MAX_SIZE < width) || (GAME_MAX_SIZE < height))
+    {
+        (void)fprintf(stderr, "Invalid game count or board size\n");
+        goto EXIT;
+    }
+
+    // the AVX2 kernel indexes every game's tiles as 32 bit halves
+    if ((INT32_MAX / (TILES_WORDS(cells) * 2)) < count)
+    {
+        (void)fprintf(stderr, "Too many games for the board size\n");
+        goto EXIT;
+    }
+
+    p_arena = arena_create(vecenv_footprint(count, cells));
+
+    if (NULL == p_arena)
+    {
+        goto EXIT;
+    }
+
+    p_env = (vecenv_t *)arena_alloc(p_arena, sizeof(vecenv_t));
+
+    int32_t ** pp_fields[] = {
+        &p_env->p_head_x,    &p_env->p_head_y,    &p_env->p_dir_x,
+        &p_env->p_dir_y,     &p_env->p_tail_cell, &p_env->p_length,
+        &p_env->p_score,     &p_env->p_is_over,   &p_env->p_next_cell,
+        &p_env->p_event,
+    };
+
+    for (size_t idx = 0; idx < (sizeof(pp_fields) / sizeof(pp_fields[0]));
+         idx++)
+    {
+        *pp_fields[idx]
+            = (int32_t *)arena_alloc(p_arena, count * sizeof(int32_t));
+    }
+
+    p_env->p_ring_head
+        = (uint32_t *)arena_alloc(p_arena, count * sizeof(uint32_t));
+    p_env->p_ring_tail
+        = (uint32_t *)arena_alloc(p_arena, count * sizeof(uint32_t));
+    p_env->p_rings
+        = (uint32_t *)arena_alloc(p_arena, count * cells * sizeof(uint32_t));
+    p_env->p_tile_words = (uint64_t *)arena_alloc(
+        p_arena, count * TILES_WORDS(cells) * sizeof(uint64_t));
+    p_env->p_empty
+        = (cellset_t *)arena_alloc(p_arena, count * sizeof(cellset_t));
+    uint32_t * p_dense
+        = (uint32_t *)arena_alloc(p_arena, count * cells * sizeof(uint32_t));
+    uint32_t * p_slots
+        = (uint32_t *)arena_alloc(p_arena, count * cells * sizeof(uint32_t));
+    p_env->p_rngs = (rng_t *)arena_alloc(p_arena, count * sizeof(rng_t));
+
+    if (NULL == p_env->p_rngs)
+    {
+        (void)fprintf(stderr, "Failed to lay out batch arena\n");
+        arena_destroy(&p_arena);
+        p_env = NULL;
+        goto EXIT;
+    }
+
+    p_env->p_arena    = p_arena;
+    p_env->count      = count;
+    p_env->width      = width;
+    p_env->height     = height;
+    p_env->cells      = cells;
+    p_env->tile_words = TILES_WORDS(cells);
+#ifdef VECENV_HAS_AVX2
+    p_env->b_use_avx2 = __builtin_cpu_supports("avx2");
+#endif
+
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        p_env->p_empty[idx] = (cellset_t) { .p_dense  = &p_dense[idx * cells],
+                                            .p_slots  = &p_slots[idx * cells],
+                                            .capacity = cells };
+        rng_seed(&p_env->p_rngs[idx], base_seed + idx);
+        vecenv_reset(p_env, idx);
+    }
+
+EXIT:
+    return (p_env);
+}
+
+void vecenv_destroy (vecenv_t ** pp_env)
+{
+    if ((NULL == pp_env) || (NULL == *pp_env))
+    {
+        goto EXIT;
+    }
+
+    // the batch itself lives in the arena, so take the arena out first
+    arena_t * p_arena = (*pp_env)->p_arena;
+
+    arena_destroy(&p_arena);
+    *pp_env = NULL;
+
+EXIT:
+    return;
+}
+
+void vecenv_reset (vecenv_t * p_env, size_t idx)
+{
+    if ((NULL == p_env) || (p_env->count <= idx))
+    {
+        goto EXIT;
+    }
+
+    cellset_t * p_empty = &p_env->p_empty[idx];
+
+    (void)memset(&p_env->p_tile_words[idx * p_env->tile_words],
+                 0,
+                 p_env->tile_words * sizeof(uint64_t));
+    cellset_init(p_empty, p_empty->p_dense, p_empty->p_slots, p_env->cells);
+
+    // the same start as game_init, so the same seed spawns the same food
+    size_t row = (p_env->height / 2) * p_env->width;
+
+    p_env->p_ring_head[idx] = (uint32_t)(p_env->cells - 1);
+    p_env->p_ring_tail[idx] = 0;
+    p_env->p_tail_cell[idx] = (int32_t)row;
+    p_env->p_length[idx]    = 0;
+    p_env->p_score[idx]     = 0;
+    p_env->p_is_over[idx]   = 0;
+    p_env->p_dir_x[idx]     = 1;
+    p_env->p_dir_y[idx]     = 0;
+
+    for (size_t x_idx = 0; x_idx < 3; x_idx++)
+    {
+        vecenv_push_head(p_env, idx, row + x_idx);
+    }
+
+    for (int start_food = 0; start_food < GAME_FOOD_COUNT; start_food++)
+    {
+        if (!vecenv_spawn_food(p_env, idx))
+        {
+            break;
+        }
+    }
+
+EXIT:
+    return;
+}
+
+size_t vecenv_step (vecenv_t * p_env, const point_t * p_dirs)
+{
+    size_t moved = 0;
+
+    if (NULL == p_env)
+    {
+        goto EXIT;
+    }
+
+    for (size_t idx = 0; (NULL != p_dirs) && (idx < p_env->count); idx++)
+    {
+        point_t dir = p_dirs[idx];
+
+        // same rule as game_turn_player, which also drops zero directions
+        if ((0 != p_env->p_dir_x[idx] + dir.x)
+            && (0 != p_env->p_dir_y[idx] + dir.y))
+        {
+            p_env->p_dir_x[idx] = dir.x;
+            p_env->p_dir_y[idx] = dir.y;
+        }
+    }
+
+    size_t done = 0;
+
+#ifdef VECENV_HAS_AVX2
+    if (p_env->b_use_avx2)
+    {
+        done = vecenv_advance_avx2(p_env);
+    }
+#endif
+
+    vecenv_advance(p_env, done, p_env->count);
+
+    for (size_t idx = 0; idx < p_env->count; idx++)
+    {
+        size_t cell = (size_t)p_env->p_next_cell[idx];
+
+        switch (p_env->p_event[idx])
+        {
+            case VECENV_MOVE:
+                vecenv_pop_tail(p_env, idx);
+                vecenv_push_head(p_env, idx, cell);
+                moved++;
+                break;
+            case VECENV_EAT:
+                p_env->p_score[idx] += ENTITY_FOOD_SCORE;
+
+                // spawn before the head covers the cell, as game_tick does,
+                // so both draw the same cells; a full board just loses it
+                (void)vecenv_spawn_food(p_env, idx);
+                vecenv_push_head(p_env, idx, cell);
+                moved++;
+                break;
+            case VECENV_HIT_BODY:
+            case VECENV_HIT_WALL:
+                p_env->p_is_over[idx] = 1;
+                break;
+            default:
+                break;
+        }
+    }
+
+EXIT:
+    return moved;
+}
+
+entity_type_t vecenv_get_tile (const vecenv_t * p_env, size_t idx, point_t pos)
+{
+    entity_type_t type = EMPTY;
+
+    if ((NULL == p_env) || (p_env->count <= idx) || (0 > pos.x) || (0 > pos.y)
+        || ((size_t)pos.x >= p_env->width) || ((size_t)pos.y >= p_env->height))
+    {
+        goto EXIT;
+    }
+
+    tiles_t tiles = vecenv_tiles(p_env, idx);
+
+    type = tiles_get(&tiles, ((size_t)pos.y * p_env->width) + (size_t)pos.x);
+
+EXIT:
+    return (type);
+}
+
+/*** end of file ***/